@@ -0,0 +1,237 @@
+#pragma once
+
+#include "em/meta/common.h"
+#include "em/meta/const_format.h"
+#include "em/meta/const_string.h"
+#include "em/meta/hash.h"
+#include "em/zstring_view.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Deferred binary logging.
+// `BinaryLog<"x = {}">(x)` doesn't format anything. It writes the message ID and the raw argument bytes into a per-thread lock-free ring buffer.
+// Some other thread periodically calls `DrainBinaryLog()` to collect the records, and they're later converted to text with `DecodeBinaryLogRecord()`,
+//   using the table of formats obtained from `GetBinaryLogFormats()` (which you should save together with the records).
+// The records use the native byte order, decode them on a machine with the same endianness.
+
+// The size of each per-thread ring buffer in bytes. Must be a power of two.
+// When a buffer overflows, the new records are dropped and counted.
+#ifndef EM_BINARY_LOG_RING_SIZE
+#define EM_BINARY_LOG_RING_SIZE (1 << 16)
+#endif
+
+// The max size of a single record. Long strings in the arguments get truncated to fit.
+#ifndef EM_BINARY_LOG_MAX_RECORD_SIZE
+#define EM_BINARY_LOG_MAX_RECORD_SIZE 1024
+#endif
+
+namespace em::Meta
+{
+    // Describes one distinct format string.
+    struct BinaryLogFormat
+    {
+        // The hash of the format string and argument types.
+        std::uint64_t id = 0;
+        zstring_view format;
+        // Two characters per argument: a kind (`b`ool, `c`har, `i`nt, `u`nsigned, `f`loat, `s`tring) and a size in bytes (`0` for strings).
+        zstring_view arg_types;
+
+        // The next format in the list returned by `GetBinaryLogFormats()`.
+        const BinaryLogFormat *next = nullptr;
+    };
+
+    // Returns the first element of the linked list of all formats used in the program. They are registered during static initialization.
+    // The list is never modified after that, except by adding new elements to the front.
+    [[nodiscard]] const BinaryLogFormat *GetBinaryLogFormats();
+
+    // Returns the format with this ID, or null if none.
+    [[nodiscard]] const BinaryLogFormat *FindBinaryLogFormat(std::uint64_t id);
+
+    // Moves all records from all per-thread buffers to the end of `out`. Each record is `[u64 id][u32 payload size][payload]`.
+    // Returns the number of records dropped (because of full buffers) since the last call.
+    // This is thread-safe, but only one thread can meaningfully drain at a time, the others wait for it.
+    std::uint64_t DrainBinaryLog(std::vector<std::byte> &out);
+
+    // Splits the output of `DrainBinaryLog()` into records, calls `func(std::uint64_t id, std::span<const std::byte> payload)` for each.
+    // Returns false if the data is truncated.
+    bool ForEachBinaryLogRecord(std::span<const std::byte> data, auto &&func)
+    {
+        while (!data.empty())
+        {
+            std::uint64_t id = 0;
+            std::uint32_t size = 0;
+            if (data.size() < sizeof id + sizeof size)
+                return false;
+            std::memcpy(&id, data.data(), sizeof id);
+            std::memcpy(&size, data.data() + sizeof id, sizeof size);
+            data = data.subspan(sizeof id + sizeof size);
+            if (data.size() < size)
+                return false;
+            func(id, data.first(size));
+            data = data.subspan(size);
+        }
+        return true;
+    }
+
+    // Converts a record payload to text, according to its format. Returns false if the payload doesn't match the format.
+    bool DecodeBinaryLogRecord(const BinaryLogFormat &format, std::span<const std::byte> payload, std::string &out);
+
+    namespace detail::BinaryLog
+    {
+        void RegisterFormat(BinaryLogFormat &format);
+
+        // A single-producer single-consumer ring buffer.
+        struct Ring
+        {
+            static constexpr std::size_t capacity = EM_BINARY_LOG_RING_SIZE;
+            static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "The ring size must be a power of two.");
+
+            std::unique_ptr<std::byte[]> data = std::make_unique<std::byte[]>(capacity);
+
+            // Those only grow, we take the remainder when indexing.
+            alignas(64) std::atomic<std::size_t> write_pos = 0; // Only written by the producer.
+            alignas(64) std::atomic<std::size_t> read_pos = 0; // Only written by the consumer.
+
+            std::atomic<std::uint64_t> num_dropped = 0;
+            // Set when the thread exits. The consumer destroys the buffer after draining it.
+            std::atomic<bool> thread_exited = false;
+
+            // The intrusive list of all buffers, protected by a mutex.
+            Ring *next = nullptr;
+
+            // Called by the producer. Never blocks.
+            void Push(std::span<const std::byte> record)
+            {
+                const std::size_t w = write_pos.load(std::memory_order_relaxed);
+                const std::size_t r = read_pos.load(std::memory_order_acquire);
+                if (capacity - (w - r) < record.size())
+                {
+                    num_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                const std::size_t offset = w & (capacity - 1);
+                const std::size_t first_part = std::min(record.size(), capacity - offset);
+                std::memcpy(data.get() + offset, record.data(), first_part);
+                std::memcpy(data.get(), record.data() + first_part, record.size() - first_part);
+
+                write_pos.store(w + record.size(), std::memory_order_release);
+            }
+        };
+
+        // Returns the buffer of the current thread, creating it on the first call.
+        // Returns null if the thread is exiting and the buffer was already released (e.g. when logging from a late `thread_local` destructor),
+        //   then the record should be dropped.
+        [[nodiscard]] Ring *ThisThreadRing();
+
+        [[nodiscard]] consteval ConstString<3> TypeCode(char kind, std::size_t size)
+        {
+            ConstString<3> ret;
+            ret.str[0] = kind;
+            ret.str[1] = char('0' + size);
+            return ret;
+        }
+
+        // Describes how an argument type is stored, see `BinaryLogFormat::arg_types`.
+        template <typename T>
+        struct ArgType {};
+        template <> struct ArgType<bool> {static constexpr ConstString<3> value = TypeCode('b', 1);};
+        template <> struct ArgType<char> {static constexpr ConstString<3> value = TypeCode('c', 1);};
+        template <typename T> requires std::is_integral_v<T> && (!same_as_any<T, bool, char>)
+        struct ArgType<T> {static constexpr ConstString<3> value = TypeCode(std::is_signed_v<T> ? 'i' : 'u', sizeof(T));};
+        template <typename T> requires std::is_floating_point_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)
+        struct ArgType<T> {static constexpr ConstString<3> value = TypeCode('f', sizeof(T));};
+        template <typename T> requires std::is_convertible_v<const T &, std::string_view> && (!std::is_arithmetic_v<T>)
+        struct ArgType<T> {static constexpr ConstString<3> value = TypeCode('s', 0);};
+
+        // Whether the arguments `P...` match the format string `Fmt`, both in count and in the placeholder specs.
+        template <ConstString Fmt, typename ...P>
+        [[nodiscard]] consteval bool ArgsMatchFormat()
+        {
+            constexpr ConstFormat::Counts counts = ConstFormat::counts<Fmt>;
+            if constexpr (!counts.ok || counts.num_args != sizeof...(P))
+                return false;
+            else
+                return [&]<std::size_t ...I>(std::index_sequence<I...>){return (formattable_with_spec<P, ConstFormat::plan<Fmt>.specs[I]> && ...);}(std::make_index_sequence<sizeof...(P)>{});
+        }
+
+        // The number of bytes an argument needs in a record, not counting the string contents.
+        template <typename T>
+        constexpr std::size_t fixed_arg_size = std::is_arithmetic_v<T> ? sizeof(T) : sizeof(std::uint32_t);
+
+        template <ConstString Fmt, ConstString ArgTypes>
+        struct Message
+        {
+            static inline BinaryLogFormat format = {
+                .id = HashCombine(HashString(Fmt.view()), HashString(ArgTypes.view())),
+                .format = Fmt.view(),
+                .arg_types = ArgTypes.view(),
+            };
+
+            static inline const bool registered = (RegisterFormat(format), true);
+        };
+
+        // Appends the raw bytes of an argument to the record.
+        // Strings are stored as `[u32 size][bytes]`, and are truncated to `string_budget`, which is then decreased by the string size.
+        template <typename T>
+        void WriteArg(std::byte *&out, std::size_t &string_budget, const T &arg)
+        {
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                std::memcpy(out, &arg, sizeof arg);
+                out += sizeof arg;
+            }
+            else
+            {
+                std::string_view str = arg;
+                std::uint32_t size = std::uint32_t(std::min(str.size(), string_budget));
+                string_budget -= size;
+                std::memcpy(out, &size, sizeof size);
+                std::memcpy(out + sizeof size, str.data(), size);
+                out += sizeof size + size;
+            }
+        }
+    }
+
+    // Whether `T` can be an argument of `BinaryLog()`.
+    template <typename T>
+    concept binary_loggable = requires{detail::BinaryLog::ArgType<T>::value;};
+
+    // Writes a log record into the buffer of the current thread. The formatting is postponed until `DecodeBinaryLogRecord()`.
+    // The format string is checked at compile-time, using the syntax of `FormatTo()`, including the number of arguments and the specs they allow.
+    // This doesn't lock and doesn't allocate (except for the first call on each thread, which allocates the buffer).
+    template <ConstString Fmt, Deduce..., binary_loggable ...P> requires (detail::BinaryLog::ArgsMatchFormat<Fmt, P...>())
+    void BinaryLog(const P &... args)
+    {
+        using Message = detail::BinaryLog::Message<Fmt, ConstStringConcat(detail::BinaryLog::ArgType<P>::value...)>;
+        (void)Message::registered;
+
+        constexpr std::size_t header_size = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+        constexpr std::size_t fixed_size = header_size + (detail::BinaryLog::fixed_arg_size<P> + ... + 0);
+        static_assert(fixed_size <= EM_BINARY_LOG_MAX_RECORD_SIZE, "Too many arguments.");
+
+        std::byte record[EM_BINARY_LOG_MAX_RECORD_SIZE];
+        std::byte *out = record + header_size;
+        [[maybe_unused]] std::size_t string_budget = EM_BINARY_LOG_MAX_RECORD_SIZE - fixed_size;
+        (detail::BinaryLog::WriteArg(out, string_budget, args), ...);
+
+        const std::uint64_t id = Message::format.id;
+        const std::uint32_t payload_size = std::uint32_t(out - record - header_size);
+        std::memcpy(record, &id, sizeof id);
+        std::memcpy(record + sizeof id, &payload_size, sizeof payload_size);
+
+        if (detail::BinaryLog::Ring *ring = detail::BinaryLog::ThisThreadRing())
+            ring->Push(std::span(record, out));
+    }
+}
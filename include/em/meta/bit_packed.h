@@ -0,0 +1,195 @@
+#pragma once
+
+#include "em/macros/portable/tiny_func.h"
+#include "em/meta/common.h"
+#include "em/meta/const_string.h"
+#include "em/meta/lists.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+// Records with fields packed to their declared bit widths.
+
+namespace em::Meta
+{
+    // Describes a field of `BitPacked`: `Bits` bits storing a `T`, which must be an integral type (including `bool`) or an enum.
+    // Signed values are sign-extended when reading.
+    template <ConstString Name, typename T, std::size_t Bits>
+    struct BitField
+    {
+        static_assert(cvref_unqualified<T> && (std::is_integral_v<T> || std::is_enum_v<T>), "The field type must be integral or an enum.");
+        static_assert(Bits > 0 && Bits <= 64, "The bit width must be between 1 and 64.");
+        static_assert(std::is_same_v<T, bool> || Bits <= sizeof(T) * 8, "The bit width is larger than the type.");
+
+        static constexpr auto name = Name;
+        using type = T;
+        static constexpr std::size_t bits = Bits;
+    };
+
+    namespace detail::BitPacked
+    {
+        template <typename T>
+        struct IsField : std::false_type {};
+        template <ConstString Name, typename T, std::size_t Bits>
+        struct IsField<BitField<Name, T, Bits>> : std::true_type {};
+
+        template <std::size_t TotalBits>
+        using word_type =
+            std::conditional_t<TotalBits <= 8, std::uint8_t,
+            std::conditional_t<TotalBits <= 16, std::uint16_t,
+            std::conditional_t<TotalBits <= 32, std::uint32_t,
+            std::uint64_t>>>;
+
+        template <std::size_t N>
+        [[nodiscard]] constexpr std::string_view NameView(const ConstString<N> &name) {return std::string_view(name.str, name.size);}
+
+        // Converts the low `Bits` bits of `raw` (the rest are zero) to `T`.
+        template <typename T, std::size_t Bits>
+        [[nodiscard]] EM_TINY constexpr T Decode(std::uint64_t raw)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return raw != 0;
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                return T(Decode<std::underlying_type_t<T>, Bits>(raw));
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                if constexpr (Bits < 64)
+                {
+                    if (raw >> (Bits - 1) & 1)
+                        raw |= ~std::uint64_t(0) << Bits; // Sign-extend.
+                }
+                return T(std::int64_t(raw));
+            }
+            else
+            {
+                return T(raw);
+            }
+        }
+
+        // Converts `value` to bits. Only the low `Bits` bits are meaningful.
+        template <typename T>
+        [[nodiscard]] EM_TINY constexpr std::uint64_t Encode(T value)
+        {
+            if constexpr (std::is_enum_v<T>)
+                return std::uint64_t(std::underlying_type_t<T>(value));
+            else
+                return std::uint64_t(value);
+        }
+    }
+
+    template <typename L>
+    class BitPacked
+    {
+        static_assert(always_false<L>, "The template argument must be a `TypeList<BitField<...>...>`.");
+    };
+
+    // A record storing the fields `F...` (which are `BitField<...>`s) back to back, using the exact declared number of bits for each.
+    // The storage is the minimal number of words, where the word is the smallest unsigned integer fitting all bits, or `uint64_t` if none do.
+    // A field can straddle two words. All offsets are computed at compile-time, so each access is a couple of shifts and masks.
+    // Setting a value that doesn't fit into the field silently truncates it.
+    template <typename ...F>
+    class BitPacked<TypeList<F...>>
+    {
+        static_assert((detail::BitPacked::IsField<F>::value && ...), "The fields must be `BitField<...>`s.");
+
+      public:
+        using fields = TypeList<F...>;
+
+        static constexpr std::size_t total_bits = (F::bits + ... + 0);
+
+        using word_type = detail::BitPacked::word_type<total_bits>;
+        static constexpr std::size_t word_bits = sizeof(word_type) * 8;
+        static constexpr std::size_t num_words = (total_bits + word_bits - 1) / word_bits;
+
+        // The bit offset of each field.
+        static constexpr std::array<std::size_t, sizeof...(F)> offsets = []{
+            std::array<std::size_t, sizeof...(F)> ret{};
+            std::size_t offset = 0, i = 0;
+            ((ret[i++] = offset, offset += F::bits), ...);
+            return ret;
+        }();
+
+        // The index of the field with this name, if there's exactly one.
+        template <ConstString Name>
+        requires (((detail::BitPacked::NameView(Name) == detail::BitPacked::NameView(F::name)) + ... + 0) == 1)
+        static constexpr std::size_t index_of = []{
+            std::size_t i = 0;
+            (void)((detail::BitPacked::NameView(Name) == detail::BitPacked::NameView(F::name) || (i++, false)) || ...);
+            return i;
+        }();
+
+        template <std::size_t I>
+        using type_at = typename F...[I]::type;
+
+      private:
+        std::array<word_type, num_words> words{};
+
+      public:
+        // Zeroes all fields.
+        constexpr BitPacked() {}
+
+        // Sets all fields, in order.
+        constexpr BitPacked(typename F::type... values) requires (sizeof...(F) > 0)
+        {
+            [&]<std::size_t ...I>(std::index_sequence<I...>){(set<I>(values), ...);}(std::index_sequence_for<F...>{});
+        }
+
+        template <std::size_t I> requires (I < sizeof...(F))
+        [[nodiscard]] EM_TINY constexpr type_at<I> get() const
+        {
+            constexpr std::size_t bits = F...[I]::bits, w = offsets[I] / word_bits, s = offsets[I] % word_bits;
+            constexpr std::uint64_t mask = bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+
+            std::uint64_t raw = std::uint64_t(words[w]) >> s;
+            if constexpr (s + bits > word_bits) // Straddles two words. This only happens with 64-bit words.
+                raw |= std::uint64_t(words[w + 1]) << (word_bits - s);
+            return detail::BitPacked::Decode<type_at<I>, bits>(raw & mask);
+        }
+        template <ConstString Name> requires requires{index_of<Name>;}
+        [[nodiscard]] EM_TINY constexpr type_at<index_of<Name>> get() const
+        {
+            return get<index_of<Name>>();
+        }
+
+        template <std::size_t I> requires (I < sizeof...(F))
+        EM_TINY constexpr void set(type_at<I> value)
+        {
+            constexpr std::size_t bits = F...[I]::bits, w = offsets[I] / word_bits, s = offsets[I] % word_bits;
+            constexpr std::uint64_t mask = bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+
+            const std::uint64_t raw = detail::BitPacked::Encode(value) & mask;
+            words[w] = word_type((words[w] & ~word_type(mask << s)) | word_type(raw << s));
+            if constexpr (s + bits > word_bits)
+                words[w + 1] = word_type((words[w + 1] & ~word_type(mask >> (word_bits - s))) | word_type(raw >> (word_bits - s)));
+        }
+        template <ConstString Name> requires requires{index_of<Name>;}
+        EM_TINY constexpr void set(type_at<index_of<Name>> value)
+        {
+            set<index_of<Name>>(value);
+        }
+
+        // Reads the `I`th field from each of the `records` into `out`, which must be at least as large.
+        // The offsets are constants, so this is a simple loop that compilers can vectorize.
+        template <std::size_t I> requires (I < sizeof...(F))
+        static constexpr void UnpackColumn(std::span<const BitPacked> records, std::span<type_at<I>> out)
+        {
+            for (std::size_t i = 0; i < records.size(); i++)
+                out[i] = records[i].template get<I>();
+        }
+        template <ConstString Name> requires requires{index_of<Name>;}
+        static constexpr void UnpackColumn(std::span<const BitPacked> records, std::span<type_at<index_of<Name>>> out)
+        {
+            UnpackColumn<index_of<Name>>(records, out);
+        }
+
+        [[nodiscard]] friend constexpr bool operator==(const BitPacked &, const BitPacked &) = default;
+    };
+}
@@ -0,0 +1,325 @@
+#pragma once
+
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/lists.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// A variant with a minimal index type, optionally stored inside of the alternatives, and flat storage.
+
+namespace em::Meta
+{
+    // Specialize this to declare a byte in `T` that doesn't affect its value (typically padding), by adding `static constexpr std::size_t offset = ...;`.
+    // If all alternatives of a `CompactVariant` either declare the same spare byte or are too small to reach it,
+    //   the variant stores its index there instead of adding a separate member.
+    // `T`'s constructors and assignments may overwrite the byte (e.g. trivial copies do), the variant rewrites its index after calling them.
+    // But any other modification could clobber the index, so the variant only gives const access to such alternatives, use `Modify()` to change them.
+    template <typename T>
+    struct CompactVariantSpareByte {};
+
+    namespace detail::CompactVariant
+    {
+        // The smallest unsigned integer that can hold the indices of `N` alternatives.
+        template <std::size_t N>
+        using index_type =
+            std::conditional_t<N <= 0xff, std::uint8_t,
+            std::conditional_t<N <= 0xffff, std::uint16_t,
+            std::uint32_t>>;
+
+        template <typename T>
+        concept HasSpareByte = requires{{CompactVariantSpareByte<T>::offset} -> std::convertible_to<std::size_t>;};
+
+        // The offset of the spare byte of `T`, or `-1` if there's none.
+        template <typename T>
+        constexpr std::size_t spare_byte_of = std::size_t(-1);
+        template <HasSpareByte T>
+        constexpr std::size_t spare_byte_of<T> = CompactVariantSpareByte<T>::offset;
+
+        // Returns the offset of the byte where the index can be stored, or `-1` if there's none.
+        template <typename ...P>
+        constexpr std::size_t spare_byte_offset = []{
+            constexpr std::size_t none = std::size_t(-1);
+            if constexpr (sizeof...(P) > 0x100)
+            {
+                return none; // The index wouldn't fit into a byte.
+            }
+            else
+            {
+                std::size_t ret = none;
+                ((HasSpareByte<P> ? (ret = spare_byte_of<P>, true) : false) || ...);
+                if (ret == none)
+                    return none;
+                bool ok = ((HasSpareByte<P> ? spare_byte_of<P> == ret : sizeof(P) <= ret) && ...);
+                return ok ? ret : none;
+            }
+        }();
+
+        struct Empty {};
+    }
+
+    // A variant of `P...` (or of the elements of a `TypeList<P...>`), stored as a flat aligned buffer.
+    // The index type is the smallest unsigned integer that fits `sizeof...(P)`. See `CompactVariantSpareByte` for storing the index inside of the alternatives.
+    // Unlike `std::variant`, converting from an alternative requires exactly that type (ignoring cvref), with no implicit conversions.
+    // All alternatives must be nothrow move-constructible, which lets this never be valueless.
+    // Works with `Meta::Visit()`.
+    template <typename ...P>
+    class CompactVariant
+    {
+        static_assert(sizeof...(P) > 0, "A variant needs at least one alternative.");
+        static_assert((std::is_nothrow_move_constructible_v<P> && ...), "The alternatives must be nothrow move-constructible.");
+        static_assert(((std::is_object_v<P> && !std::is_array_v<P> && cv_unqualified<P>) && ...), "The alternatives must be cv-unqualified non-array object types.");
+        static_assert(((!detail::CompactVariant::HasSpareByte<P> || detail::CompactVariant::spare_byte_of<P> < sizeof(P)) && ...), "The spare byte offset must be less than the size of the type.");
+
+      public:
+        using types = TypeList<P...>;
+        using index_type = detail::CompactVariant::index_type<sizeof...(P)>;
+
+        static constexpr std::size_t spare_byte_offset = detail::CompactVariant::spare_byte_offset<P...>;
+        static constexpr bool index_in_spare_byte = spare_byte_offset != std::size_t(-1);
+
+        // The index of `T` in the alternatives, if it appears exactly once.
+        template <typename T> requires ((std::is_same_v<T, P> + ...) == 1)
+        static constexpr std::size_t index_of = []{std::size_t i = 0; (void)((std::is_same_v<T, P> || (i++, false)) || ...); return i;}();
+
+        // Whether the accessors return the `I`th alternative as non-const. This is false if the index is stored in its spare byte.
+        template <std::size_t I> requires (I < sizeof...(P))
+        static constexpr bool mutable_alternative = !index_in_spare_byte || !detail::CompactVariant::HasSpareByte<P...[I]>;
+
+        // The `I`th alternative, possibly made const according to `mutable_alternative`.
+        template <std::size_t I>
+        using access_type = maybe_const<!mutable_alternative<I>, P...[I]>;
+
+      private:
+        static constexpr bool trivially_copyable = (std::is_trivially_copyable_v<P> && ...);
+        static constexpr bool trivially_destructible = (std::is_trivially_destructible_v<P> && ...);
+
+        alignas(P...) std::byte buffer[std::max({sizeof(P)..., index_in_spare_byte ? spare_byte_offset + 1 : 1})];
+        [[no_unique_address]] std::conditional_t<index_in_spare_byte, detail::CompactVariant::Empty, index_type> separate_index;
+
+        void SetIndex(std::size_t i) noexcept
+        {
+            if constexpr (index_in_spare_byte)
+                buffer[spare_byte_offset] = std::byte(i);
+            else
+                separate_index = index_type(i);
+        }
+
+        // Calls `func.template operator()<I>()` for the runtime index `i`. Compilers turn the chain of comparisons into a `switch`.
+        template <typename F>
+        static constexpr void WithIndex(std::size_t i, F &&func)
+        {
+            [&]<std::size_t ...I>(std::index_sequence<I...>){
+                (void)((i == I && (func.template operator()<I>(), true)) || ...);
+            }(std::index_sequence_for<P...>{});
+        }
+
+        // Returns the `I`th alternative without checking the index, without the constness from `access_type`.
+        template <std::size_t I, typename Self>
+        [[nodiscard]] copy_cvref<Self &&, P...[I]> Raw(this Self &&self) noexcept
+        {
+            return static_cast<copy_cvref<Self &&, P...[I]>>(*std::launder(reinterpret_cast<copy_cv<Self, P...[I]> *>(self.buffer)));
+        }
+
+        template <std::size_t I, typename ...A>
+        void Construct(A &&... args) noexcept(std::is_nothrow_constructible_v<P...[I], A &&...>)
+        {
+            using T = P...[I];
+            ::new((void *)buffer) T(EM_FWD(args)...);
+            SetIndex(I); // After constructing, in case the constructor touched the spare byte.
+        }
+
+        void Destroy() noexcept
+        {
+            if constexpr (!trivially_destructible)
+                WithIndex(index(), [&]<std::size_t I>{std::destroy_at(&Raw<I>());});
+        }
+
+      public:
+        // Value-initializes the first alternative, like `std::variant`.
+        CompactVariant() noexcept(std::is_nothrow_default_constructible_v<P...[0]>) requires std::is_default_constructible_v<P...[0]>
+        {
+            Construct<0>();
+        }
+
+        template <std::size_t I, typename ...A> requires (I < sizeof...(P)) && std::is_constructible_v<P...[I], A &&...>
+        explicit CompactVariant(std::in_place_index_t<I>, A &&... args) noexcept(std::is_nothrow_constructible_v<P...[I], A &&...>)
+        {
+            Construct<I>(EM_FWD(args)...);
+        }
+
+        template <typename T, typename ...A> requires requires{index_of<T>;} && std::is_constructible_v<T, A &&...>
+        explicit CompactVariant(std::in_place_type_t<T>, A &&... args) noexcept(std::is_nothrow_constructible_v<T, A &&...>)
+        {
+            Construct<index_of<T>>(EM_FWD(args)...);
+        }
+
+        // Constructs from one of the alternatives.
+        template <typename T> requires requires{index_of<std::remove_cvref_t<T>>;} && std::is_constructible_v<std::remove_cvref_t<T>, T &&>
+        CompactVariant(T &&value) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<T>, T &&>)
+        {
+            Construct<index_of<std::remove_cvref_t<T>>>(EM_FWD(value));
+        }
+
+        CompactVariant(const CompactVariant &) requires trivially_copyable = default;
+        CompactVariant(const CompactVariant &other) noexcept((std::is_nothrow_copy_constructible_v<P> && ...)) requires (!trivially_copyable && (std::is_copy_constructible_v<P> && ...))
+        {
+            WithIndex(other.index(), [&]<std::size_t I>{Construct<I>(other.template Raw<I>());});
+        }
+
+        CompactVariant(CompactVariant &&) requires trivially_copyable = default;
+        CompactVariant(CompactVariant &&other) noexcept requires (!trivially_copyable)
+        {
+            WithIndex(other.index(), [&]<std::size_t I>{Construct<I>(std::move(other).template Raw<I>());});
+        }
+
+        CompactVariant &operator=(const CompactVariant &) requires trivially_copyable = default;
+        CompactVariant &operator=(const CompactVariant &other) requires (!trivially_copyable && ((std::is_copy_constructible_v<P> && std::is_copy_assignable_v<P>) && ...))
+        {
+            if (this == &other)
+                return *this;
+            if (index() == other.index())
+                WithIndex(index(), [&]<std::size_t I>{Raw<I>() = other.template Raw<I>(); SetIndex(I);});
+            else
+                *this = CompactVariant(other); // Copy first, so that if it throws, we're unchanged.
+            return *this;
+        }
+
+        CompactVariant &operator=(CompactVariant &&) requires trivially_copyable = default;
+        CompactVariant &operator=(CompactVariant &&other) noexcept((std::is_nothrow_move_assignable_v<P> && ...)) requires (!trivially_copyable && (std::is_move_assignable_v<P> && ...))
+        {
+            if (this == &other)
+                return *this;
+            if (index() == other.index())
+            {
+                WithIndex(index(), [&]<std::size_t I>{Raw<I>() = std::move(other).template Raw<I>(); SetIndex(I);});
+            }
+            else
+            {
+                Destroy();
+                WithIndex(other.index(), [&]<std::size_t I>{Construct<I>(std::move(other).template Raw<I>());});
+            }
+            return *this;
+        }
+
+        ~CompactVariant() requires trivially_destructible = default;
+        ~CompactVariant() requires (!trivially_destructible)
+        {
+            Destroy();
+        }
+
+        // Replaces the current alternative with a new one.
+        // If constructing can throw, constructs a temporary first and then moves it in, so the old alternative is kept on failure.
+        template <std::size_t I, typename ...A> requires (I < sizeof...(P)) && std::is_constructible_v<P...[I], A &&...>
+        access_type<I> &emplace(A &&... args) noexcept(std::is_nothrow_constructible_v<P...[I], A &&...>)
+        {
+            if constexpr (std::is_nothrow_constructible_v<P...[I], A &&...>)
+            {
+                Destroy();
+                Construct<I>(EM_FWD(args)...);
+            }
+            else
+            {
+                P...[I] temp(EM_FWD(args)...);
+                Destroy();
+                Construct<I>(std::move(temp));
+            }
+            return get_unchecked<I>();
+        }
+        template <typename T, typename ...A> requires requires{index_of<T>;} && std::is_constructible_v<T, A &&...>
+        access_type<index_of<T>> &emplace(A &&... args) noexcept(std::is_nothrow_constructible_v<T, A &&...>)
+        {
+            return emplace<index_of<T>>(EM_FWD(args)...);
+        }
+
+        [[nodiscard]] std::size_t index() const noexcept
+        {
+            if constexpr (index_in_spare_byte)
+                return std::size_t(buffer[spare_byte_offset]);
+            else
+                return separate_index;
+        }
+
+        // This is never valueless, this is only for compatibility with `std::variant`.
+        [[nodiscard]] static constexpr bool valueless_by_exception() noexcept {return false;}
+
+        template <typename T> requires requires{index_of<T>;}
+        [[nodiscard]] bool holds_alternative() const noexcept {return index() == index_of<T>;}
+
+        // Returns the `I`th alternative without checking the index.
+        template <std::size_t I, typename Self> requires (I < sizeof...(P))
+        [[nodiscard]] copy_cvref<Self &&, access_type<I>> get_unchecked(this Self &&self) noexcept
+        {
+            return EM_FWD(self).template Raw<I>();
+        }
+
+        // Returns the `I`th alternative, or throws `std::bad_variant_access` if it's not active.
+        template <std::size_t I, typename Self> requires (I < sizeof...(P))
+        [[nodiscard]] copy_cvref<Self &&, access_type<I>> get(this Self &&self)
+        {
+            if (self.index() != I)
+                throw std::bad_variant_access{};
+            return EM_FWD(self).template get_unchecked<I>();
+        }
+        template <typename T, typename Self> requires requires{index_of<T>;}
+        [[nodiscard]] copy_cvref<Self &&, access_type<index_of<T>>> get(this Self &&self)
+        {
+            return EM_FWD(self).template get<index_of<T>>();
+        }
+
+        // Returns a pointer to the `I`th alternative, or null if it's not active.
+        template <std::size_t I, typename Self> requires (I < sizeof...(P))
+        [[nodiscard]] copy_cv<Self, access_type<I>> *get_if(this Self &self) noexcept
+        {
+            return self.index() == I ? &self.template get_unchecked<I>() : nullptr;
+        }
+        template <typename T, typename Self> requires requires{index_of<T>;}
+        [[nodiscard]] copy_cv<Self, access_type<index_of<T>>> *get_if(this Self &self) noexcept
+        {
+            return self.template get_if<index_of<T>>();
+        }
+
+        // Calls `func(alternative)` with a non-const reference to the `I`th alternative, and returns the result.
+        // Throws `std::bad_variant_access` if it's not active. Rewrites the index afterwards (even if `func` throws),
+        //   so this is the only way to modify the alternatives that store the index in their spare byte.
+        template <std::size_t I, typename F> requires (I < sizeof...(P)) && std::is_invocable_v<F &&, P...[I] &>
+        decltype(auto) Modify(F &&func)
+        {
+            if (index() != I)
+                throw std::bad_variant_access{};
+
+            struct RestoreIndex
+            {
+                CompactVariant &self;
+                ~RestoreIndex() {self.SetIndex(I);}
+            };
+            RestoreIndex restore_index{*this};
+            return std::invoke(EM_FWD(func), Raw<I>());
+        }
+        template <typename T, typename F> requires requires{index_of<T>;} && std::is_invocable_v<F &&, T &>
+        decltype(auto) Modify(F &&func)
+        {
+            return Modify<index_of<T>>(EM_FWD(func));
+        }
+    };
+
+    template <typename ...P>
+    class CompactVariant<TypeList<P...>> : public CompactVariant<P...>
+    {
+        using CompactVariant<P...>::CompactVariant;
+    };
+}
+
+template <typename ...P>
+struct std::variant_size<em::Meta::CompactVariant<P...>> : std::integral_constant<std::size_t, em::Meta::list_size<typename em::Meta::CompactVariant<P...>::types>> {};
+
+template <std::size_t I, typename ...P>
+struct std::variant_alternative<I, em::Meta::CompactVariant<P...>> {using type = em::Meta::list_type_at<typename em::Meta::CompactVariant<P...>::types, I>;};
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "em/meta/common.h"
+#include "em/meta/const_string.h"
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Formatting with format strings parsed at compile-time, into caller-provided buffers.
+// The syntax is a small subset of `std::format()`: `{}` is a placeholder, `{:x}` and `{:X}` are hex placeholders (for integers only),
+//   and `{{`, `}}` are escaped braces.
+
+namespace em::Meta
+{
+    enum class FormatSpec : std::uint8_t
+    {
+        none,
+        hex,
+        hex_upper,
+    };
+
+    // Parses a format string. Calls `on_literal(char)` for each literal character and `on_arg(FormatSpec)` for each placeholder, in order.
+    // Returns false if the string is invalid, possibly after calling the callbacks for the valid part.
+    // This is usable both at compile-time and at runtime.
+    [[nodiscard]] constexpr bool ParseFormatString(std::string_view fmt, auto &&on_literal, auto &&on_arg)
+    {
+        for (std::size_t i = 0; i < fmt.size(); i++)
+        {
+            const char ch = fmt[i];
+            if (ch == '}')
+            {
+                if (i + 1 >= fmt.size() || fmt[i + 1] != '}')
+                    return false; // Unescaped `}`.
+                on_literal('}');
+                i++;
+            }
+            else if (ch == '{')
+            {
+                if (i + 1 < fmt.size() && fmt[i + 1] == '{')
+                {
+                    on_literal('{');
+                    i++;
+                    continue;
+                }
+
+                std::size_t close = fmt.find('}', i);
+                if (close == std::string_view::npos)
+                    return false; // Unclosed `{`.
+
+                std::string_view spec = fmt.substr(i + 1, close - i - 1);
+                if (spec.empty())
+                    on_arg(FormatSpec::none);
+                else if (spec == ":x")
+                    on_arg(FormatSpec::hex);
+                else if (spec == ":X")
+                    on_arg(FormatSpec::hex_upper);
+                else
+                    return false; // Unknown spec.
+
+                i = close;
+            }
+            else
+            {
+                on_literal(ch);
+            }
+        }
+        return true;
+    }
+
+    // Whether `T` can be passed to `FormatTo()` with this spec.
+    template <typename T, FormatSpec Spec = FormatSpec::none>
+    concept formattable_with_spec =
+        (Spec == FormatSpec::none && (std::is_arithmetic_v<T> || std::is_convertible_v<const T &, std::string_view>)) ||
+        (Spec != FormatSpec::none && std::is_integral_v<T> && !same_as_any<T, bool, char>);
+
+    namespace detail::ConstFormat
+    {
+        struct Counts
+        {
+            bool ok = false;
+            std::size_t num_args = 0;
+            std::size_t num_literal_chars = 0;
+        };
+
+        [[nodiscard]] consteval Counts Count(std::string_view fmt)
+        {
+            Counts ret;
+            ret.ok = ParseFormatString(fmt, [&](char){ret.num_literal_chars++;}, [&](FormatSpec){ret.num_args++;});
+            return ret;
+        }
+
+        // The parsed format string.
+        template <std::size_t NumArgs, std::size_t NumLiteralChars>
+        struct Plan
+        {
+            // All literal characters, unescaped.
+            std::array<char, NumLiteralChars> text{};
+            // `literal_ends[i]` is where the literal before the `i`-th placeholder ends in `text`. The last element is always `NumLiteralChars`.
+            std::array<std::size_t, NumArgs + 1> literal_ends{};
+            std::array<FormatSpec, NumArgs> specs{};
+
+            consteval Plan(std::string_view fmt)
+            {
+                std::size_t num_chars = 0;
+                std::size_t num_args = 0;
+                (void)ParseFormatString(fmt,
+                    [&](char ch){text[num_chars++] = ch;},
+                    [&](FormatSpec spec){literal_ends[num_args] = num_chars; specs[num_args++] = spec;}
+                );
+                literal_ends.back() = num_chars;
+            }
+        };
+
+        template <ConstString Fmt>
+        constexpr Counts counts = Count(Fmt.view());
+
+        template <ConstString Fmt> requires(counts<Fmt>.ok)
+        constexpr Plan<counts<Fmt>.num_args, counts<Fmt>.num_literal_chars> plan = Plan<counts<Fmt>.num_args, counts<Fmt>.num_literal_chars>(Fmt.view());
+
+        [[nodiscard]] constexpr bool WriteString(char *&out, char *end, std::string_view str)
+        {
+            if (std::size_t(end - out) < str.size())
+                return false;
+            for (char ch : str)
+                *out++ = ch;
+            return true;
+        }
+
+        template <FormatSpec Spec, typename T>
+        [[nodiscard]] constexpr bool WriteArg(char *&out, char *end, const T &arg)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return WriteString(out, end, arg ? "true" : "false");
+            }
+            else if constexpr (std::is_same_v<T, char>)
+            {
+                return WriteString(out, end, std::string_view(&arg, 1));
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                char *begin = out;
+                std::to_chars_result result;
+                if constexpr (Spec == FormatSpec::none)
+                    result = std::to_chars(out, end, arg);
+                else
+                    result = std::to_chars(out, end, arg, 16);
+
+                if (result.ec != std::errc{})
+                    return false;
+                out = result.ptr;
+
+                if constexpr (Spec == FormatSpec::hex_upper)
+                {
+                    for (char *ptr = begin; ptr != out; ptr++)
+                    {
+                        if (*ptr >= 'a' && *ptr <= 'f')
+                            *ptr = char(*ptr - 'a' + 'A');
+                    }
+                }
+                return true;
+            }
+            else
+            {
+                return WriteString(out, end, std::string_view(arg));
+            }
+        }
+    }
+
+    // Formats `args` according to `Fmt` into `buffer`. Doesn't allocate and doesn't null-terminate.
+    // The format string is parsed at compile-time, and the argument types are checked against it.
+    // Returns the pointer past the last written character, or null if the buffer is too small (then the buffer contents are unspecified).
+    template <ConstString Fmt, Deduce..., typename ...P>
+    [[nodiscard]] constexpr char *FormatTo(std::span<char> buffer, const P &... args)
+    {
+        constexpr detail::ConstFormat::Counts counts = detail::ConstFormat::counts<Fmt>;
+        static_assert(counts.ok, "Invalid format string.");
+        static_assert(counts.num_args == sizeof...(P), "The number of arguments doesn't match the format string.");
+        if constexpr (!counts.ok || counts.num_args != sizeof...(P))
+        {
+            return nullptr; // Avoid cascading errors.
+        }
+        else
+        {
+            constexpr const auto &plan = detail::ConstFormat::plan<Fmt>;
+
+            char *out = buffer.data();
+            char *const end = out + buffer.size();
+
+            bool ok = [&]<std::size_t ...I>(std::index_sequence<I...>)
+            {
+                static_assert((formattable_with_spec<P, plan.specs[I]> && ...), "Some of the argument types can't be formatted with those specs.");
+
+                return (
+                    (
+                        detail::ConstFormat::WriteString(out, end, std::string_view(plan.text.data() + (I == 0 ? 0 : plan.literal_ends[I - 1]), plan.text.data() + plan.literal_ends[I])) &&
+                        detail::ConstFormat::WriteArg<plan.specs[I]>(out, end, args)
+                    ) && ...
+                );
+            }(std::make_index_sequence<sizeof...(P)>{});
+
+            ok = ok && detail::ConstFormat::WriteString(out, end, std::string_view(plan.text.data() + (sizeof...(P) == 0 ? 0 : plan.literal_ends[sizeof...(P) - 1]), plan.text.data() + plan.text.size()));
+
+            return ok ? out : nullptr;
+        }
+    }
+}
@@ -0,0 +1,606 @@
+#pragma once
+
+#include "em/meta/const_string.h"
+#include "em/zstring_view.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Matching strings against regexes and globs that are compiled to DFAs at compile-time.
+// Unlike `std::regex`, nothing is constructed at runtime, and matching is a single pass over the string with one table lookup per character.
+
+namespace em::Meta
+{
+    enum class PatternSyntax
+    {
+        // A regex subset: literal characters, `.` (any character), `[...]` and `[^...]` (with ranges and escapes),
+        //   escapes `\d \D \w \W \s \S \n \r \t` and `\` followed by punctuation, groups `(...)`, alternatives `|`, and quantifiers `* + ?`.
+        // The whole string must match, there are no anchors. No backreferences, no lazy quantifiers, no `{n,m}`.
+        regex,
+        // `*` matches any sequence of characters except `/`, `?` matches any single character except `/`,
+        //   `[...]` and `[!...]` (or `[^...]`) match a character from a set (never `/`), and `\` escapes the next character.
+        // `**/` at the beginning or after a `/` matches zero or more directories, like in gitignore, so `src/**/*.cpp` matches both `src/a.cpp` and `src/x/y/a.cpp`.
+        // Any other `**` matches any sequence including `/`.
+        glob,
+    };
+
+    namespace detail::ConstPattern
+    {
+        struct CharSet
+        {
+            std::array<std::uint64_t, 4> bits{};
+
+            constexpr void Add(unsigned char ch)
+            {
+                bits[ch / 64] |= std::uint64_t(1) << (ch % 64);
+            }
+            constexpr void AddRange(unsigned char first, unsigned char last)
+            {
+                for (unsigned ch = first; ch <= last; ch++)
+                    Add((unsigned char)ch);
+            }
+            constexpr void Add(const CharSet &other)
+            {
+                for (std::size_t i = 0; i < bits.size(); i++)
+                    bits[i] |= other.bits[i];
+            }
+            constexpr void Invert()
+            {
+                for (std::uint64_t &word : bits)
+                    word = ~word;
+            }
+
+            [[nodiscard]] constexpr bool Contains(unsigned char ch) const
+            {
+                return bits[ch / 64] >> (ch % 64) & 1;
+            }
+        };
+
+        [[nodiscard]] constexpr CharSet AllCharsExcept(std::string_view excluded)
+        {
+            CharSet ret;
+            for (char ch : excluded)
+                ret.Add((unsigned char)ch);
+            ret.Invert();
+            return ret;
+        }
+
+        // A Thompson NFA.
+        struct Nfa
+        {
+            static constexpr std::size_t none = std::size_t(-1);
+
+            struct State
+            {
+                // If this isn't `none`, this state consumes a character from `sets[set]` and goes to `next[0]`.
+                // Otherwise it goes to `next[0]` and `next[1]` (those that aren't `none`) without consuming anything.
+                std::size_t set = none;
+                std::size_t next[2] = {none, none};
+            };
+
+            // A piece of the automaton. `end` never consumes characters, and has no outgoing edges until the fragment is attached to something.
+            struct Fragment
+            {
+                std::size_t start = 0;
+                std::size_t end = 0;
+            };
+
+            std::vector<CharSet> sets;
+            std::vector<State> states;
+
+            // The whole automaton.
+            Fragment root;
+
+            constexpr std::size_t AddState(std::size_t set = none, std::size_t next0 = none, std::size_t next1 = none)
+            {
+                states.push_back({.set = set, .next = {next0, next1}});
+                return states.size() - 1;
+            }
+
+            constexpr Fragment Empty()
+            {
+                std::size_t state = AddState();
+                return {state, state};
+            }
+
+            constexpr Fragment Chars(const CharSet &set)
+            {
+                sets.push_back(set);
+                std::size_t end = AddState();
+                return {AddState(sets.size() - 1, end), end};
+            }
+
+            constexpr Fragment Concat(Fragment a, Fragment b)
+            {
+                states[a.end].next[0] = b.start;
+                return {a.start, b.end};
+            }
+
+            constexpr Fragment Alternative(Fragment a, Fragment b)
+            {
+                std::size_t end = AddState();
+                states[a.end].next[0] = end;
+                states[b.end].next[0] = end;
+                return {AddState(none, a.start, b.start), end};
+            }
+
+            constexpr Fragment Star(Fragment a)
+            {
+                std::size_t end = AddState();
+                states[a.end].next[0] = a.start;
+                states[a.end].next[1] = end;
+                return {AddState(none, a.start, end), end};
+            }
+
+            constexpr Fragment Plus(Fragment a)
+            {
+                std::size_t end = AddState();
+                states[a.end].next[0] = a.start;
+                states[a.end].next[1] = end;
+                return {a.start, end};
+            }
+
+            constexpr Fragment Optional(Fragment a)
+            {
+                std::size_t end = AddState();
+                states[a.end].next[0] = end;
+                return {AddState(none, a.start, end), end};
+            }
+        };
+
+        // Parses a pattern into an NFA.
+        class Parser
+        {
+            PatternSyntax syntax;
+            std::string_view str;
+            std::size_t pos = 0;
+            Nfa &nfa;
+
+            [[nodiscard]] constexpr bool AtEnd() const {return pos == str.size();}
+
+            // Stops the compilation.
+            [[noreturn]] static void Fail()
+            {
+                std::unreachable(); // Invalid pattern. This causes a compilation error.
+            }
+
+            struct Escape
+            {
+                CharSet set;
+                // If the escape is a single character, this is it. Otherwise -1.
+                int single = -1;
+            };
+
+            // Parses the part after `\`.
+            [[nodiscard]] constexpr Escape ParseEscape()
+            {
+                if (AtEnd())
+                    Fail();
+                char ch = str[pos++];
+
+                Escape ret;
+
+                if (syntax == PatternSyntax::regex)
+                {
+                    switch (ch)
+                    {
+                      case 'd':
+                      case 'D':
+                        ret.set.AddRange('0', '9');
+                        if (ch == 'D')
+                            ret.set.Invert();
+                        return ret;
+                      case 'w':
+                      case 'W':
+                        ret.set.AddRange('a', 'z');
+                        ret.set.AddRange('A', 'Z');
+                        ret.set.AddRange('0', '9');
+                        ret.set.Add('_');
+                        if (ch == 'W')
+                            ret.set.Invert();
+                        return ret;
+                      case 's':
+                      case 'S':
+                        for (char space : std::string_view(" \t\n\r\f\v"))
+                            ret.set.Add((unsigned char)space);
+                        if (ch == 'S')
+                            ret.set.Invert();
+                        return ret;
+                      case 'n': ch = '\n'; break;
+                      case 'r': ch = '\r'; break;
+                      case 't': ch = '\t'; break;
+                      default:
+                        // Reject unknown letter escapes, to leave room for adding them later.
+                        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9'))
+                            Fail();
+                        break;
+                    }
+                }
+
+                ret.set.Add((unsigned char)ch);
+                ret.single = (unsigned char)ch;
+                return ret;
+            }
+
+            // Parses the part after `[`, including the closing `]`.
+            [[nodiscard]] constexpr CharSet ParseBracket()
+            {
+                CharSet ret;
+
+                bool negate = false;
+                if (!AtEnd() && (str[pos] == '^' || (syntax == PatternSyntax::glob && str[pos] == '!')))
+                {
+                    negate = true;
+                    pos++;
+                }
+
+                auto ParseElem = [&]() -> Escape
+                {
+                    if (AtEnd())
+                        Fail();
+                    char ch = str[pos++];
+                    if (ch == '\\')
+                        return ParseEscape();
+                    Escape elem;
+                    elem.set.Add((unsigned char)ch);
+                    elem.single = (unsigned char)ch;
+                    return elem;
+                };
+
+                // `]` right after the opening bracket is a literal.
+                bool first = true;
+                while (first || AtEnd() || str[pos] != ']')
+                {
+                    first = false;
+
+                    Escape elem = ParseElem();
+                    if (str.size() - pos >= 2 && str[pos] == '-' && str[pos + 1] != ']')
+                    {
+                        pos++;
+                        Escape last = ParseElem();
+                        if (elem.single < 0 || last.single < 0 || elem.single > last.single)
+                            Fail();
+                        ret.AddRange((unsigned char)elem.single, (unsigned char)last.single);
+                    }
+                    else
+                    {
+                        ret.Add(elem.set);
+                    }
+                }
+                pos++; // Skip `]`.
+
+                if (negate)
+                    ret.Invert();
+
+                // Slashes can only be matched literally in globs.
+                if (syntax == PatternSyntax::glob)
+                    ret.bits[0] &= ~(std::uint64_t(1) << '/');
+
+                return ret;
+            }
+
+            // Regex: a single item, without the quantifier.
+            [[nodiscard]] constexpr Nfa::Fragment ParseRegexAtom()
+            {
+                char ch = str[pos++];
+                switch (ch)
+                {
+                  case '(':
+                    {
+                        Nfa::Fragment ret = ParseRegexAlternatives();
+                        if (AtEnd() || str[pos] != ')')
+                            Fail();
+                        pos++;
+                        return ret;
+                    }
+                  case '[':
+                    return nfa.Chars(ParseBracket());
+                  case '.':
+                    return nfa.Chars(AllCharsExcept(""));
+                  case '\\':
+                    return nfa.Chars(ParseEscape().set);
+                  case '*':
+                  case '+':
+                  case '?':
+                  case '{':
+                  case '}':
+                  case ']':
+                  case '^':
+                  case '$':
+                    Fail(); // Those must be escaped.
+                  default:
+                    {
+                        CharSet set;
+                        set.Add((unsigned char)ch);
+                        return nfa.Chars(set);
+                    }
+                }
+            }
+
+            // Regex: a sequence of items with optional quantifiers.
+            [[nodiscard]] constexpr Nfa::Fragment ParseRegexSequence()
+            {
+                Nfa::Fragment ret = nfa.Empty();
+                while (!AtEnd() && str[pos] != '|' && str[pos] != ')')
+                {
+                    Nfa::Fragment item = ParseRegexAtom();
+                    while (!AtEnd() && (str[pos] == '*' || str[pos] == '+' || str[pos] == '?'))
+                    {
+                        switch (str[pos++])
+                        {
+                            case '*': item = nfa.Star(item); break;
+                            case '+': item = nfa.Plus(item); break;
+                            case '?': item = nfa.Optional(item); break;
+                        }
+                    }
+                    ret = nfa.Concat(ret, item);
+                }
+                return ret;
+            }
+
+            // Regex: sequences separated by `|`.
+            [[nodiscard]] constexpr Nfa::Fragment ParseRegexAlternatives()
+            {
+                Nfa::Fragment ret = ParseRegexSequence();
+                while (!AtEnd() && str[pos] == '|')
+                {
+                    pos++;
+                    ret = nfa.Alternative(ret, ParseRegexSequence());
+                }
+                return ret;
+            }
+
+            [[nodiscard]] constexpr Nfa::Fragment ParseGlob()
+            {
+                Nfa::Fragment ret = nfa.Empty();
+                while (!AtEnd())
+                {
+                    char ch = str[pos++];
+                    Nfa::Fragment item;
+                    switch (ch)
+                    {
+                      case '*':
+                        if (!AtEnd() && str[pos] == '*')
+                        {
+                            const bool starts_component = pos == 1 || str[pos - 2] == '/';
+                            pos++;
+                            item = nfa.Star(nfa.Chars(AllCharsExcept("")));
+                            if (starts_component && !AtEnd() && str[pos] == '/')
+                            {
+                                // Zero or more directories: `(.*/)?`.
+                                pos++;
+                                CharSet slash;
+                                slash.Add((unsigned char)'/');
+                                item = nfa.Optional(nfa.Concat(item, nfa.Chars(slash)));
+                            }
+                        }
+                        else
+                        {
+                            item = nfa.Star(nfa.Chars(AllCharsExcept("/")));
+                        }
+                        break;
+                      case '?':
+                        item = nfa.Chars(AllCharsExcept("/"));
+                        break;
+                      case '[':
+                        item = nfa.Chars(ParseBracket());
+                        break;
+                      case '\\':
+                        item = nfa.Chars(ParseEscape().set);
+                        break;
+                      default:
+                        {
+                            CharSet set;
+                            set.Add((unsigned char)ch);
+                            item = nfa.Chars(set);
+                        }
+                        break;
+                    }
+                    ret = nfa.Concat(ret, item);
+                }
+                return ret;
+            }
+
+          public:
+            constexpr Parser(PatternSyntax syntax, std::string_view str, Nfa &nfa) : syntax(syntax), str(str), nfa(nfa) {}
+
+            constexpr void Parse()
+            {
+                if (syntax == PatternSyntax::regex)
+                {
+                    nfa.root = ParseRegexAlternatives();
+                    if (!AtEnd())
+                        Fail(); // Unbalanced `)`.
+                }
+                else
+                {
+                    nfa.root = ParseGlob();
+                }
+            }
+        };
+
+        // A DFA produced from an NFA by the subset construction.
+        // This uses dynamic allocation, so it only exists temporarily during constant evaluation, and is then copied to a `Table`.
+        struct Dfa
+        {
+            // Maps each byte to a character class. The bytes in the same class are indistinguishable for the pattern.
+            std::array<std::uint8_t, 256> char_classes{};
+            std::size_t num_classes = 1;
+
+            // State 0 is the dead state (no match is possible from it), state 1 is the initial state.
+            std::size_t num_states = 0;
+            // `transitions[state * num_classes + char_class]` is the next state.
+            std::vector<std::size_t> transitions;
+            std::vector<bool> accepts;
+
+            constexpr Dfa(PatternSyntax syntax, std::string_view pattern)
+            {
+                Nfa nfa;
+                Parser(syntax, pattern, nfa).Parse();
+
+                // Split the bytes into classes, until each set contains either the entire class or nothing from it.
+                for (const CharSet &set : nfa.sets)
+                {
+                    // Zero means "not assigned yet", so this stores the new class plus one, which can be 256.
+                    std::array<std::uint16_t, 256 * 2> renumber{};
+                    std::size_t new_num_classes = 0;
+                    for (std::size_t ch = 0; ch < 256; ch++)
+                    {
+                        std::uint16_t &new_class = renumber[char_classes[ch] * 2 + set.Contains((unsigned char)ch)];
+                        if (new_class == 0)
+                            new_class = std::uint16_t(++new_num_classes);
+                        char_classes[ch] = std::uint8_t(new_class - 1);
+                    }
+                    num_classes = new_num_classes;
+                }
+
+                std::array<unsigned char, 256> class_representatives{};
+                for (std::size_t ch = 256; ch-- > 0;)
+                    class_representatives[char_classes[ch]] = (unsigned char)ch;
+
+                // The subset construction. Each DFA state is a bit mask of NFA states.
+                using StateSet = std::vector<std::uint64_t>;
+                const std::size_t num_words = (nfa.states.size() + 63) / 64;
+
+                auto Contains = [](const StateSet &set, std::size_t state) {return bool(set[state / 64] >> (state % 64) & 1);};
+
+                std::vector<std::size_t> stack;
+                auto AddWithClosure = [&](StateSet &set, std::size_t state)
+                {
+                    if (Contains(set, state))
+                        return;
+                    set[state / 64] |= std::uint64_t(1) << (state % 64);
+                    stack.push_back(state);
+                    while (!stack.empty())
+                    {
+                        const Nfa::State &cur = nfa.states[stack.back()];
+                        stack.pop_back();
+                        if (cur.set != Nfa::none)
+                            continue;
+                        for (std::size_t next : cur.next)
+                        {
+                            if (next != Nfa::none && !Contains(set, next))
+                            {
+                                set[next / 64] |= std::uint64_t(1) << (next % 64);
+                                stack.push_back(next);
+                            }
+                        }
+                    }
+                };
+
+                std::vector<StateSet> dfa_states;
+                dfa_states.push_back(StateSet(num_words)); // The dead state.
+                dfa_states.push_back(StateSet(num_words));
+                AddWithClosure(dfa_states.back(), nfa.root.start);
+
+                for (std::size_t i = 0; i < dfa_states.size(); i++)
+                {
+                    accepts.push_back(Contains(dfa_states[i], nfa.root.end));
+
+                    for (std::size_t c = 0; c < num_classes; c++)
+                    {
+                        StateSet next(num_words);
+                        for (std::size_t s = 0; s < nfa.states.size(); s++)
+                        {
+                            if (!Contains(dfa_states[i], s))
+                                continue;
+                            const Nfa::State &state = nfa.states[s];
+                            if (state.set != Nfa::none && nfa.sets[state.set].Contains(class_representatives[c]))
+                                AddWithClosure(next, state.next[0]);
+                        }
+
+                        std::size_t index = 0;
+                        while (index < dfa_states.size() && dfa_states[index] != next)
+                            index++;
+                        if (index == dfa_states.size())
+                            dfa_states.push_back(std::move(next));
+                        transitions.push_back(index);
+                    }
+                }
+
+                num_states = dfa_states.size();
+            }
+        };
+
+        struct DfaSize
+        {
+            std::size_t num_states = 0;
+            std::size_t num_classes = 0;
+        };
+
+        [[nodiscard]] consteval DfaSize ComputeDfaSize(PatternSyntax syntax, std::string_view pattern)
+        {
+            Dfa dfa(syntax, pattern);
+            return {dfa.num_states, dfa.num_classes};
+        }
+
+        template <std::size_t NumStates, std::size_t NumClasses>
+        struct Table
+        {
+            // Stores state indices premultiplied by `NumClasses`.
+            using state_t = std::conditional_t<(NumStates * NumClasses <= 0xff), std::uint8_t, std::conditional_t<(NumStates * NumClasses <= 0xffff), std::uint16_t, std::uint32_t>>;
+
+            std::array<std::uint8_t, 256> char_classes{};
+
+            // `transitions[state + char_class]` is the next state. The dead state is 0, the initial state is `NumClasses`.
+            std::array<state_t, NumStates * NumClasses> transitions{};
+
+            // Whether the string matches if it ends in this state. Indexed by the state divided by `NumClasses`.
+            std::array<bool, NumStates> accepts{};
+
+            consteval Table(PatternSyntax syntax, std::string_view pattern)
+            {
+                Dfa dfa(syntax, pattern);
+                char_classes = dfa.char_classes;
+                for (std::size_t i = 0; i < transitions.size(); i++)
+                    transitions[i] = state_t(dfa.transitions[i] * NumClasses);
+                for (std::size_t i = 0; i < NumStates; i++)
+                    accepts[i] = dfa.accepts[i];
+            }
+        };
+    }
+
+    // Matches strings against a pattern that's compiled to a DFA at compile-time. See `PatternSyntax` for the supported syntax.
+    // Usage: `ConstRegex<"[a-z]+\\.(cpp|h)">::Match("foo.cpp")`, or `ConstGlob<"src/**/*.cpp">::Match(path)`.
+    // The whole string must match. An invalid pattern causes a compilation error.
+    template <PatternSyntax Syntax, ConstString Pattern>
+    struct ConstPattern
+    {
+        static constexpr PatternSyntax syntax = Syntax;
+
+        [[nodiscard]] static constexpr zstring_view pattern() {return Pattern.view();}
+
+      private:
+        static constexpr detail::ConstPattern::DfaSize dfa_size = detail::ConstPattern::ComputeDfaSize(Syntax, Pattern.view());
+        static constexpr detail::ConstPattern::Table<dfa_size.num_states, dfa_size.num_classes> table{Syntax, Pattern.view()};
+
+      public:
+        // The number of DFA states, including the dead state.
+        static constexpr std::size_t num_states = dfa_size.num_states;
+
+        // Whether the entire `str` matches the pattern.
+        // This looks at each character at most once, does no allocations, and stops as soon as a match becomes impossible.
+        [[nodiscard]] static constexpr bool Match(std::string_view str)
+        {
+            std::size_t state = dfa_size.num_classes;
+            for (char ch : str)
+            {
+                state = table.transitions[state + table.char_classes[(unsigned char)ch]];
+                if (state == 0)
+                    return false;
+            }
+            return table.accepts[state / dfa_size.num_classes];
+        }
+    };
+
+    template <ConstString Pattern>
+    using ConstRegex = ConstPattern<PatternSyntax::regex, Pattern>;
+
+    template <ConstString Pattern>
+    using ConstGlob = ConstPattern<PatternSyntax::glob, Pattern>;
+}
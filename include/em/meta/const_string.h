@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace em::Meta
@@ -35,41 +36,120 @@ namespace em::Meta
         [[nodiscard]] constexpr zstring_view view() const && = delete;
     };
 
+
+    // A tag structure returned by `operator""_const` below.
+    template <Meta::ConstString S>
+    struct ConstStringTag
+    {
+        static constexpr Meta::ConstString value = S;
+    };
+
+    // Returns a string encoded into a template parameter of a tag structure `ConstStringTag`.
+    template <Meta::ConstString S>
+    [[nodiscard]] constexpr ConstStringTag<S> operator""_c()
+    {
+        return {};
+    }
+
+    namespace detail::ConstStrings
+    {
+        template <typename T> struct IsTag : std::false_type {};
+        template <ConstString S> struct IsTag<ConstStringTag<S>> : std::true_type {};
+    }
+
+    // Whether `T` is a `ConstStringTag<...>`, i.e. the type of `"..."_c`.
+    template <typename T>
+    concept const_string_tag = detail::ConstStrings::IsTag<T>::value;
+
+
+    namespace detail::ConstStrings
+    {
+        // The length of a string that `ConstStringConcat()` accepts, without the null-terminator.
+        template <typename T> struct Length {};
+        template <std::size_t N> struct Length<ConstString<N>> : std::integral_constant<std::size_t, N - 1> {};
+        template <std::size_t N> struct Length<char[N]> : std::integral_constant<std::size_t, N - 1> {};
+        template <ConstString S> struct Length<ConstStringTag<S>> : std::integral_constant<std::size_t, S.size> {};
+
+        template <std::size_t N>
+        [[nodiscard]] constexpr std::string_view View(const ConstString<N> &str) {return std::string_view(str.str, N - 1);}
+        template <std::size_t N>
+        [[nodiscard]] constexpr std::string_view View(const char (&str)[N]) {return std::string_view(str, N - 1);}
+        template <ConstString S>
+        [[nodiscard]] constexpr std::string_view View(ConstStringTag<S>) {return std::string_view(S.str, S.size);}
+    }
+
+    // Concatenates any number of `ConstString`s, string literals and `"..."_c` tags.
+    // Unlike chaining `operator+`, this sizes the result once and copies each character once.
+    template <typename ...P>
+    [[nodiscard]] constexpr ConstString<(detail::ConstStrings::Length<P>::value + ... + 1)> ConstStringConcat(const P &... strings)
+    {
+        ConstString<(detail::ConstStrings::Length<P>::value + ... + 1)> ret;
+        [[maybe_unused]] std::size_t pos = 0; // Unused if there are no strings.
+        ([&]{
+            for (char ch : detail::ConstStrings::View(strings))
+                ret.str[pos++] = ch;
+        }(), ...);
+        return ret;
+    }
+
     template <std::size_t A, std::size_t B>
     [[nodiscard]] constexpr ConstString<A + B - 1> operator+(const ConstString<A> &a, const ConstString<B> &b)
     {
-        ConstString<A + B - 1> ret;
-        std::copy_n(a.str, a.size, ret.str);
-        std::copy_n(b.str, b.size, ret.str + a.size);
-        return ret;
+        return ConstStringConcat(a, b);
     }
 
     template <std::size_t A, std::size_t B>
     [[nodiscard]] constexpr ConstString<A + B - 1> operator+(const ConstString<A> &a, const char (&b)[B])
     {
-        return a + ConstString<B>(b);
+        return ConstStringConcat(a, b);
     }
 
     template <std::size_t A, std::size_t B>
     [[nodiscard]] constexpr ConstString<A + B - 1> operator+(const char (&a)[A], const ConstString<B> &b)
     {
-        return ConstString<A>(a) + b;
+        return ConstStringConcat(a, b);
     }
 
 
-    // A tag structure returned by `operator""_const` below.
-    template <Meta::ConstString S>
-    struct ConstStringTag
+    // Assembles a string step by step in constexpr code, without instantiating a new `ConstString<N>` for every step.
+    // `Capacity` includes the null-terminator. Use `ConstStringFromBuilder` to convert the result to a `ConstString`.
+    template <std::size_t Capacity>
+    struct ConstStringBuilder
     {
-        static constexpr Meta::ConstString value = S;
+        char str[Capacity]{};
+        std::size_t size = 0;
+
+        constexpr ConstStringBuilder &operator+=(std::string_view new_str)
+        {
+            if (new_str.size() >= Capacity - size)
+                std::unreachable(); // Not enough capacity. This causes a compilation error in constant evaluation.
+
+            for (char ch : new_str)
+                str[size++] = ch;
+            return *this;
+        }
+
+        constexpr ConstStringBuilder &operator+=(char ch)
+        {
+            return *this += std::string_view(&ch, 1);
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const
+        {
+            return std::string_view(str, size);
+        }
     };
 
-    // Returns a string encoded into a template parameter of a tag structure `ConstStringTag`.
-    template <Meta::ConstString S>
-    [[nodiscard]] constexpr ConstStringTag<S> operator""_c()
-    {
-        return {};
-    }
+    // `F` is a lambda returning a `ConstStringBuilder`. Calls it at compile-time, and converts the result to a `ConstString` of the exact size.
+    // Usage: `ConstStringFromBuilder<[]{ConstStringBuilder<100> b; b += "foo"; return b;}>`.
+    template <auto F>
+    constexpr auto ConstStringFromBuilder = []{
+        constexpr auto builder = F();
+        ConstString<builder.size + 1> ret;
+        for (std::size_t i = 0; i < builder.size; i++)
+            ret.str[i] = builder.str[i];
+        return ret;
+    }();
 }
 
 namespace em::inline Common
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "em/meta/const_string.h"
+#include "em/meta/perfect_hash.h"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace em::Meta
+{
+    // Maps strings to their indices in the list of keys, using a perfect hash generated at compile-time.
+    // Usage: `ConstStringMap<"foo"_c, "bar"_c>::Find("bar") == 1`.
+    // To map to values, store them in an array indexed by the result of `Find()`.
+    template <auto ...Keys> requires (const_string_tag<std::remove_cvref_t<decltype(Keys)>> && ...)
+    struct ConstStringMap
+    {
+        static constexpr std::size_t size = sizeof...(Keys);
+
+        static constexpr PerfectStringHash<size> hash = std::array<std::string_view, size>{std::string_view(decltype(Keys)::value.str, decltype(Keys)::value.size)...};
+
+        // Returns the index of `key` in `Keys...`, or `size` if it's not one of them.
+        [[nodiscard]] static constexpr std::size_t Find(std::string_view key)
+        {
+            return hash.Find(key);
+        }
+    };
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "em/meta/const_string.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Longest-prefix matching against a fixed set of keywords, using a trie generated at compile-time.
+
+namespace em::Meta
+{
+    namespace detail::ConstStringTrie
+    {
+        // Maps each byte to a character class. Class 0 is for the bytes that don't appear in any keyword.
+        struct CharClasses
+        {
+            std::array<std::uint8_t, 256> map{};
+            std::size_t num_classes = 1;
+        };
+
+        template <std::size_t N>
+        [[nodiscard]] consteval CharClasses ComputeCharClasses(const std::array<std::string_view, N> &keys)
+        {
+            CharClasses ret;
+            for (std::string_view key : keys)
+            {
+                for (char ch : key)
+                {
+                    std::uint8_t &c = ret.map[(unsigned char)ch];
+                    if (c == 0)
+                        c = std::uint8_t(ret.num_classes++);
+                }
+            }
+            return ret;
+        }
+
+        template <std::size_t N>
+        [[nodiscard]] consteval std::size_t CountStates(const std::array<std::string_view, N> &keys)
+        {
+            // One state for the root, and one for each distinct non-empty prefix.
+            std::size_t ret = 1;
+            for (std::size_t i = 0; i < N; i++)
+            {
+                for (std::size_t len = 1; len <= keys[i].size(); len++)
+                {
+                    bool is_new = true;
+                    for (std::size_t j = 0; is_new && j < i; j++)
+                        is_new = !keys[j].starts_with(keys[i].substr(0, len));
+                    ret += is_new;
+                }
+            }
+            return ret;
+        }
+
+        template <std::size_t N, std::size_t NumStates, std::size_t NumClasses>
+        struct Table
+        {
+            using state_t = std::conditional_t<(NumStates <= 0xffff), std::uint16_t, std::uint32_t>;
+
+            std::array<std::uint8_t, 256> char_classes{};
+
+            // `transitions[state * NumClasses + char_class]` is the next state. The root is state 0.
+            // Since nothing transitions back to the root, we use 0 as the dead state.
+            std::array<state_t, NumStates * NumClasses> transitions{};
+
+            // The index of the keyword that ends at this state plus one, or 0 if none.
+            std::array<state_t, NumStates> accepts{};
+
+            consteval Table(const std::array<std::string_view, N> &keys, const CharClasses &classes)
+                : char_classes(classes.map)
+            {
+                static_assert(N < std::size_t(state_t(-1)), "Too many keywords.");
+
+                std::size_t num_states = 1;
+                for (std::size_t i = 0; i < N; i++)
+                {
+                    std::size_t state = 0;
+                    for (char ch : keys[i])
+                    {
+                        state_t &next = transitions[state * NumClasses + char_classes[(unsigned char)ch]];
+                        if (next == 0)
+                            next = state_t(num_states++);
+                        state = next;
+                    }
+
+                    if (accepts[state] != 0)
+                        std::unreachable(); // Duplicate keyword. This causes a compilation error.
+                    accepts[state] = state_t(i + 1);
+                }
+            }
+        };
+    }
+
+    // Matches the longest keyword at the beginning of a string, using a trie (with compressed character classes) generated at compile-time.
+    // Usage: `ConstStringTrie<"<"_c, "<="_c, "<<"_c>::MatchLongestPrefix("<<=")` returns `{.index = 2, .length = 2}`.
+    // The keywords must be distinct.
+    template <auto ...Keys> requires (const_string_tag<std::remove_cvref_t<decltype(Keys)>> && ...)
+    struct ConstStringTrie
+    {
+        static constexpr std::size_t size = sizeof...(Keys);
+
+        static constexpr std::array<std::string_view, size> keys = {std::string_view(decltype(Keys)::value.str, decltype(Keys)::value.size)...};
+
+      private:
+        static constexpr detail::ConstStringTrie::CharClasses classes = detail::ConstStringTrie::ComputeCharClasses(keys);
+        static constexpr std::size_t num_classes = classes.num_classes;
+        static constexpr std::size_t num_states = detail::ConstStringTrie::CountStates(keys);
+        static constexpr detail::ConstStringTrie::Table<size, num_states, num_classes> table{keys, classes};
+
+      public:
+        struct MatchResult
+        {
+            // The keyword index, or `size` if nothing matched.
+            std::size_t index = size;
+            // The keyword length, or 0 if nothing matched.
+            std::size_t length = 0;
+
+            [[nodiscard]] constexpr explicit operator bool() const {return index != size;}
+        };
+
+        // Finds the longest keyword that `str` starts with.
+        // This looks at each character of `str` at most once, and stops as soon as no keyword can match.
+        [[nodiscard]] static constexpr MatchResult MatchLongestPrefix(std::string_view str)
+        {
+            MatchResult ret;
+            if (table.accepts[0])
+                ret.index = table.accepts[0] - 1;
+
+            std::size_t state = 0;
+            for (std::size_t i = 0; i < str.size(); i++)
+            {
+                state = table.transitions[state * num_classes + table.char_classes[(unsigned char)str[i]]];
+                if (state == 0)
+                    break;
+                if (table.accepts[state])
+                {
+                    ret.index = table.accepts[state] - 1;
+                    ret.length = i + 1;
+                }
+            }
+
+            return ret;
+        }
+    };
+}
@@ -2,7 +2,13 @@
 
 #include "em/macros/utils/implies.h"
 #include "em/macros/utils/flag_enum.h"
+#include "em/meta/type_id.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <type_traits>
 #include <typeinfo>
 
@@ -68,6 +74,26 @@ namespace em::Meta
 
     constexpr CvrefFlagsAndType type_to_desc = {.flags = cvref_to_flags<T>, .type = &typeid(T)};
 
+    // Combines `CvrefFlags` and `TypeId`. Unlike `CvrefFlagsAndType`, this can be compared in constant expressions,
+    //   and comparing the types is always a single pointer comparison.
+    struct CvrefFlagsAndTypeId
+    {
+        CvrefFlags flags{};
+
+        // This is always cvref-unqualified.
+        TypeId type;
+
+        // Converts to the `std::type_info`-based descriptor.
+        [[nodiscard]] CvrefFlagsAndType ToTypeInfoDesc() const
+        {
+            return {.flags = flags, .type = &type.type_info()};
+        }
+    };
+
+    // Returns `CvrefFlags` and `TypeId` for a type.
+    template <typename T>
+    constexpr CvrefFlagsAndTypeId type_to_desc_id = {.flags = cvref_to_flags<T>, .type = type_id<std::remove_cvref_t<T>>};
+
     // Checks that `from` flags are convertible to `to` flags.
     // If `to` is a non-ref, this version always returns false (you must check for that manually, taking into account copyability/movability of the type).
     // If `from` is a non-ref, it's assumed to be an rvalue ref. You can adjust it manually before calling if you don't like this.
@@ -84,6 +110,36 @@ namespace em::Meta
             ((from & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref) == ((to & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref);
     }
 
+    namespace detail
+    {
+        // The part of `SameTypeAndConstructibleFromDesc()` that doesn't check the type.
+        template <typename T>
+        [[nodiscard]] constexpr bool ConstructibleFromFlags(CvrefFlags flags)
+        {
+            if constexpr (std::is_reference_v<T>)
+            {
+                return CvrefFlagsConvertible(flags, cvref_to_flags<T>);
+            }
+            else
+            {
+                if (bool(flags & CvrefFlags::const_))
+                    return (flags & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref ? std::is_constructible_v<T, const T &> : std::is_constructible_v<T, const T &&>;
+                else
+                    return (flags & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref ? std::is_constructible_v<T, T &> : std::is_constructible_v<T, T &&>;
+            }
+        }
+
+        // The part of `SameTypeAndDescIsConstructibleFrom()` that doesn't check the type.
+        template <typename T>
+        [[nodiscard]] constexpr bool FlagsAreConstructibleFrom(CvrefFlags flags)
+        {
+            if (bool(flags & CvrefFlags::ref_mask))
+                return CvrefFlagsConvertible(cvref_to_flags<T>, flags);
+            else
+                return std::is_constructible_v<std::remove_cvref_t<T>, T &&>;
+        }
+    }
+
     // Checks that `T` is constructible from `desc`, and both are the same type ignoring cvref-qualifiers.
     // If `from` is a non-ref, it's assumed to be an rvalue ref. You can adjust it manually before calling if you don't like this.
     template <typename T>
@@ -92,17 +148,12 @@ namespace em::Meta
         if (*desc.type != typeid(T))
             return false;
 
-        if constexpr (std::is_reference_v<T>)
-        {
-            return CvrefFlagsConvertible(desc.flags, cvref_to_flags<T>);
-        }
-        else
-        {
-            if (bool(desc.flags & CvrefFlags::const_))
-                return (desc.flags & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref ? std::is_constructible_v<T, const T &> : std::is_constructible_v<T, const T &&>;
-            else
-                return (desc.flags & CvrefFlags::ref_mask) == CvrefFlags::lvalue_ref ? std::is_constructible_v<T, T &> : std::is_constructible_v<T, T &&>;
-        }
+        return detail::ConstructibleFromFlags<T>(desc.flags);
+    }
+    template <typename T>
+    [[nodiscard]] constexpr bool SameTypeAndConstructibleFromDesc(const CvrefFlagsAndTypeId &desc)
+    {
+        return desc.type == type_id<std::remove_cvref_t<T>> && detail::ConstructibleFromFlags<T>(desc.flags);
     }
 
     // Checks that `desc` is constructible from `T`, and both are the same type ignoring cvref-qualifiers.
@@ -113,9 +164,66 @@ namespace em::Meta
         if (*desc.type != typeid(T))
             return false;
 
-        if (bool(desc.flags & CvrefFlags::ref_mask))
-            return CvrefFlagsConvertible(cvref_to_flags<T>, desc.flags);
-        else
-            return std::is_constructible_v<std::remove_cvref_t<T>, T &&>;
+        return detail::FlagsAreConstructibleFrom<T>(desc.flags);
+    }
+    template <typename T>
+    [[nodiscard]] constexpr bool SameTypeAndDescIsConstructibleFrom(const CvrefFlagsAndTypeId &desc)
+    {
+        return desc.type == type_id<std::remove_cvref_t<T>> && detail::FlagsAreConstructibleFrom<T>(desc.flags);
+    }
+
+
+    // Describes a function parameter, for checking many arguments at once.
+    // Bit `i` in `accepts` says whether an argument with `CvrefFlags(i)` can be passed to this parameter, assuming the types match.
+    struct CvrefParamDesc
+    {
+        TypeId type;
+        std::uint8_t accepts = 0;
+    };
+
+    // Returns `CvrefParamDesc` for a parameter type `T`, using the same rules as `SameTypeAndConstructibleFromDesc()`.
+    template <typename T>
+    constexpr CvrefParamDesc type_to_param_desc = []{
+        CvrefParamDesc ret{.type = type_id<std::remove_cvref_t<T>>};
+        for (unsigned char i = 0; i < (unsigned char)CvrefFlags::end_value; i++)
+        {
+            if (detail::ConstructibleFromFlags<T>(CvrefFlags(i)))
+                ret.accepts |= std::uint8_t(1 << i);
+        }
+        return ret;
+    }();
+
+    // Checks a list of arguments against a list of parameters, equivalent to calling `SameTypeAndConstructibleFromDesc()` for each.
+    // Returns the index of the first mismatch, or `min(params.size(), args.size())` if there are none. Compare the sizes separately.
+    // The elements are checked in small blocks without branching, which lets the compiler vectorize this.
+    [[nodiscard]] constexpr std::size_t FindFirstMismatchingArg(std::span<const CvrefParamDesc> params, std::span<const CvrefFlagsAndTypeId> args)
+    {
+        constexpr std::size_t block_size = 8;
+
+        const std::size_t n = std::min(params.size(), args.size());
+        for (std::size_t i = 0; i < n; i += block_size)
+        {
+            const std::size_t cur_block_size = std::min(block_size, n - i);
+
+            std::uint32_t mismatches = 0;
+            for (std::size_t j = 0; j < cur_block_size; j++)
+            {
+                const CvrefParamDesc &param = params[i + j];
+                const CvrefFlagsAndTypeId &arg = args[i + j];
+                // Intentionally using the bitwise operators to avoid branching.
+                mismatches |= std::uint32_t((param.type != arg.type) | !((param.accepts >> (unsigned char)arg.flags) & 1)) << j;
+            }
+
+            if (mismatches)
+                return i + std::size_t(std::countr_zero(mismatches));
+        }
+
+        return n;
+    }
+
+    // Returns true if the argument list matches the parameter list, including the sizes.
+    [[nodiscard]] constexpr bool ArgsMatchParams(std::span<const CvrefParamDesc> params, std::span<const CvrefFlagsAndTypeId> args)
+    {
+        return params.size() == args.size() && FindFirstMismatchingArg(params, args) == params.size();
     }
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "em/meta/cvref_extras.h"
+#include "em/meta/hash.h"
+#include "em/meta/lists.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Picks an overload for type-erased arguments, given a compile-time list of candidate signatures.
+
+namespace em::Meta
+{
+    namespace detail::DynamicOverload
+    {
+        template <typename L>
+        struct CandidateParams {};
+        template <typename ...P>
+        struct CandidateParams<TypeList<P...>>
+        {
+            static constexpr std::array<CvrefParamDesc, sizeof...(P)> value = {type_to_param_desc<P>...};
+        };
+
+        // Whether some argument list is accepted by both parameter lists.
+        [[nodiscard]] constexpr bool ParamsOverlap(std::span<const CvrefParamDesc> a, std::span<const CvrefParamDesc> b)
+        {
+            if (a.size() != b.size())
+                return false;
+            for (std::size_t i = 0; i < a.size(); i++)
+            {
+                if (a[i].type != b[i].type || (a[i].accepts & b[i].accepts) == 0)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    // `Candidates` is a `TypeList<TypeList<Params...>...>`, one inner list per overload.
+    // `CacheSize` is the number of remembered argument lists, must be a power of two.
+    template <typename Candidates, std::size_t CacheSize = 64>
+    class DynamicOverloadResolver {};
+
+    template <typename ...C, std::size_t CacheSize>
+    class DynamicOverloadResolver<TypeList<C...>, CacheSize>
+    {
+        static_assert(CacheSize > 0 && (CacheSize & (CacheSize - 1)) == 0, "The cache size must be a power of two.");
+        static_assert(sizeof...(C) < 0xffff, "Too many overloads.");
+
+        static constexpr std::array<std::span<const CvrefParamDesc>, sizeof...(C)> candidates = {std::span<const CvrefParamDesc>(detail::DynamicOverload::CandidateParams<C>::value)...};
+
+        // Each entry is `(hash & ~0xffff) | (index + 1)`, or zero if empty.
+        // Since each entry is a single word, we don't need anything stronger than relaxed atomics.
+        std::array<std::atomic<std::uint64_t>, CacheSize> cache{};
+
+      public:
+        // The value returned when no overload matches.
+        static constexpr std::size_t no_match = sizeof...(C);
+
+        // `shadowed_by[i][j]` (for `j < i`) is true if some argument list is accepted by both candidates `i` and `j`, in which case `j` wins.
+        static constexpr std::array<std::array<bool, sizeof...(C)>, sizeof...(C)> shadowed_by = []{
+            std::array<std::array<bool, sizeof...(C)>, sizeof...(C)> ret{};
+            for (std::size_t i = 0; i < sizeof...(C); i++)
+            {
+                for (std::size_t j = 0; j < i; j++)
+                    ret[i][j] = detail::DynamicOverload::ParamsOverlap(candidates[i], candidates[j]);
+            }
+            return ret;
+        }();
+
+        // Hashes the argument list. This is what the cache is keyed on.
+        [[nodiscard]] static constexpr std::uint64_t HashArgs(std::span<const CvrefFlagsAndTypeId> args)
+        {
+            std::uint64_t ret = args.size();
+            for (const CvrefFlagsAndTypeId &arg : args)
+                ret = HashCombine(ret, arg.type.hash() ^ (unsigned char)arg.flags);
+            return ret;
+        }
+
+        // Checks all the candidates in order, and returns the index of the first one accepting the arguments, or `no_match`.
+        [[nodiscard]] static constexpr std::size_t ResolveUncached(std::span<const CvrefFlagsAndTypeId> args)
+        {
+            for (std::size_t i = 0; i < sizeof...(C); i++)
+            {
+                if (ArgsMatchParams(candidates[i], args))
+                    return i;
+            }
+            return no_match;
+        }
+
+        // Returns true if `ResolveUncached(args)` would return `index`, assuming that candidate `index` accepts `args`.
+        // This only re-checks the earlier candidates that can accept the same arguments as `index` (see `shadowed_by`), often there are none.
+        [[nodiscard]] static constexpr bool NotShadowed(std::size_t index, std::span<const CvrefFlagsAndTypeId> args)
+        {
+            for (std::size_t j = 0; j < index; j++)
+            {
+                if (shadowed_by[index][j] && ArgsMatchParams(candidates[j], args))
+                    return false;
+            }
+            return true;
+        }
+
+        // Same as `ResolveUncached()`, but remembers the results, so repeating the same argument list usually only costs a hash and a check of one candidate.
+        // This is thread-safe and lock-free.
+        // A cached result is always re-checked against the arguments, including the earlier candidates that overlap with it,
+        //   so hash collisions can't produce a different result than `ResolveUncached()`.
+        // Failures are not cached, we don't expect them to be on the hot path.
+        [[nodiscard]] std::size_t Resolve(std::span<const CvrefFlagsAndTypeId> args)
+        {
+            const std::uint64_t hash = HashArgs(args);
+            std::atomic<std::uint64_t> &entry = cache[hash & (CacheSize - 1)];
+
+            const std::uint64_t cached = entry.load(std::memory_order_relaxed);
+            if (cached && (cached & ~std::uint64_t(0xffff)) == (hash & ~std::uint64_t(0xffff)))
+            {
+                const std::size_t index = std::size_t(cached & 0xffff) - 1;
+                if (ArgsMatchParams(candidates[index], args) && NotShadowed(index, args))
+                    return index;
+            }
+
+            const std::size_t ret = ResolveUncached(args);
+            if (ret != no_match)
+                entry.store((hash & ~std::uint64_t(0xffff)) | (ret + 1), std::memory_order_relaxed);
+            return ret;
+        }
+
+        // Forgets all cached results.
+        void ClearCache()
+        {
+            for (std::atomic<std::uint64_t> &entry : cache)
+                entry.store(0, std::memory_order_relaxed);
+        }
+    };
+}
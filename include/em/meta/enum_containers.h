@@ -0,0 +1,335 @@
+#pragma once
+
+#include "em/meta/common.h"
+#include "em/meta/enum_reflection.h"
+#include "em/meta/lists.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+// Containers indexed by enums: `EnumSet<E>` is a bitset, `EnumArray<E, T>` is an array with one element per enumerator.
+// The enumerators come from `enum_values<E>` (reflection) by default, or can be listed explicitly as a `ValueList<...>`.
+
+namespace em::Meta
+{
+    namespace detail::EnumContainers
+    {
+        // Maps the values from the list `L` to their positions in it.
+        template <typename E, typename L>
+        struct Indexer
+        {
+            static_assert(always_false<E, L>, "The enumerators must be a `ValueList<...>` of distinct values of type `E`.");
+        };
+
+        template <typename E, auto ...V> requires std::is_enum_v<E> && (std::is_same_v<decltype(V), E> && ...)
+        struct Indexer<E, ValueList<V...>>
+        {
+            static constexpr std::size_t size = sizeof...(V);
+
+            static constexpr std::array<E, size> values = {V...};
+
+            using index_t = std::conditional_t<(size < 0xff), std::uint8_t, std::conditional_t<(size < 0xffff), std::uint16_t, std::uint32_t>>;
+
+            static constexpr std::int64_t first = std::min({std::int64_t(V)..., std::numeric_limits<std::int64_t>::max()});
+            static constexpr std::int64_t last = std::max({std::int64_t(V)..., std::numeric_limits<std::int64_t>::min()});
+            static constexpr std::uint64_t span = size == 0 ? 0 : std::uint64_t(last) - std::uint64_t(first) + 1;
+
+            // If the values aren't too sparse, map them with a lookup table. Otherwise use a binary search.
+            static constexpr bool use_table = span <= size * 4 + 64;
+
+            // Maps `value - first` to the index, or `size` for the holes.
+            static constexpr std::array<index_t, use_table ? span : 0> table = []{
+                std::array<index_t, use_table ? span : 0> ret{};
+                std::fill(ret.begin(), ret.end(), index_t(size));
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    index_t &elem = ret[std::size_t(std::int64_t(values[i]) - first)];
+                    if (elem != size)
+                        std::unreachable(); // Duplicate values. This causes a compilation error.
+                    elem = index_t(i);
+                }
+                return ret;
+            }();
+
+            struct SortedEntry
+            {
+                std::int64_t value = 0;
+                index_t index = 0;
+            };
+
+            static constexpr std::array<SortedEntry, use_table ? 0 : size> sorted = []{
+                std::array<SortedEntry, use_table ? 0 : size> ret{};
+                for (std::size_t i = 0; i < ret.size(); i++)
+                    ret[i] = {std::int64_t(values[i]), index_t(i)};
+                std::sort(ret.begin(), ret.end(), [](const SortedEntry &a, const SortedEntry &b){return a.value < b.value;});
+                for (std::size_t i = 1; i < ret.size(); i++)
+                {
+                    if (ret[i - 1].value == ret[i].value)
+                        std::unreachable(); // Duplicate values. This causes a compilation error.
+                }
+                return ret;
+            }();
+
+            // Returns the position of `value` in the list, or `size` if it's not there.
+            [[nodiscard]] static constexpr std::size_t IndexOf(E value)
+            {
+                if constexpr (size == 0)
+                {
+                    (void)value;
+                    return 0;
+                }
+                else if constexpr (use_table)
+                {
+                    // Using unsigned arithmetic to handle the values on both sides of the range with one comparison.
+                    const std::uint64_t offset = std::uint64_t(std::int64_t(value)) - std::uint64_t(first);
+                    return offset < span ? table[offset] : size;
+                }
+                else
+                {
+                    auto it = std::lower_bound(sorted.begin(), sorted.end(), std::int64_t(value), [](const SortedEntry &a, std::int64_t b){return a.value < b;});
+                    return it != sorted.end() && it->value == std::int64_t(value) ? it->index : size;
+                }
+            }
+        };
+    }
+
+    // A set of enumerators, stored as a bitset with one bit per enumerator.
+    // `L` is a `ValueList` of the allowed values, by default all enumerators found by reflection.
+    // Adding values that aren't in `L` does nothing. The set operations process 64 bits at a time.
+    template <typename E, typename L = enum_values<E>>
+    class EnumSet
+    {
+        using Indexer = detail::EnumContainers::Indexer<E, L>;
+
+      public:
+        using value_type = E;
+        using values = L;
+
+        // The number of values that can be stored.
+        static constexpr std::size_t capacity = Indexer::size;
+
+      private:
+        static constexpr std::size_t num_words = (capacity + 63) / 64;
+
+        // The unused bits of the last word must stay zero.
+        static constexpr std::uint64_t last_word_mask = capacity % 64 == 0 ? std::uint64_t(-1) : (std::uint64_t(1) << (capacity % 64)) - 1;
+
+        std::array<std::uint64_t, num_words> words{};
+
+      public:
+        constexpr EnumSet() {}
+
+        constexpr EnumSet(std::initializer_list<E> list)
+        {
+            for (E value : list)
+                Insert(value);
+        }
+
+        // Returns a set with all values from `L`.
+        [[nodiscard]] static constexpr EnumSet All()
+        {
+            EnumSet ret;
+            ret.words.fill(std::uint64_t(-1));
+            if constexpr (num_words > 0)
+                ret.words.back() &= last_word_mask;
+            return ret;
+        }
+
+        [[nodiscard]] constexpr bool Contains(E value) const
+        {
+            std::size_t i = Indexer::IndexOf(value);
+            return i < capacity && (words[i / 64] >> (i % 64) & 1);
+        }
+
+        // Returns true if the value wasn't in the set before, and is in `L`.
+        constexpr bool Insert(E value)
+        {
+            std::size_t i = Indexer::IndexOf(value);
+            if (i == capacity)
+                return false;
+            const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+            const bool ret = !(words[i / 64] & bit);
+            words[i / 64] |= bit;
+            return ret;
+        }
+
+        // Returns true if the value was in the set.
+        constexpr bool Erase(E value)
+        {
+            std::size_t i = Indexer::IndexOf(value);
+            if (i == capacity)
+                return false;
+            const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+            const bool ret = words[i / 64] & bit;
+            words[i / 64] &= ~bit;
+            return ret;
+        }
+
+        constexpr void Clear()
+        {
+            words.fill(0);
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const
+        {
+            std::size_t ret = 0;
+            for (std::uint64_t word : words)
+                ret += std::size_t(std::popcount(word));
+            return ret;
+        }
+
+        [[nodiscard]] constexpr bool empty() const
+        {
+            return std::all_of(words.begin(), words.end(), [](std::uint64_t word){return word == 0;});
+        }
+
+        [[nodiscard]] constexpr bool ContainsAll(const EnumSet &other) const
+        {
+            for (std::size_t i = 0; i < num_words; i++)
+            {
+                if (other.words[i] & ~words[i])
+                    return false;
+            }
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool Intersects(const EnumSet &other) const
+        {
+            for (std::size_t i = 0; i < num_words; i++)
+            {
+                if (other.words[i] & words[i])
+                    return true;
+            }
+            return false;
+        }
+
+        constexpr EnumSet &operator|=(const EnumSet &other) {for (std::size_t i = 0; i < num_words; i++) words[i] |= other.words[i]; return *this;}
+        constexpr EnumSet &operator&=(const EnumSet &other) {for (std::size_t i = 0; i < num_words; i++) words[i] &= other.words[i]; return *this;}
+        constexpr EnumSet &operator^=(const EnumSet &other) {for (std::size_t i = 0; i < num_words; i++) words[i] ^= other.words[i]; return *this;}
+        constexpr EnumSet &operator-=(const EnumSet &other) {for (std::size_t i = 0; i < num_words; i++) words[i] &= ~other.words[i]; return *this;}
+
+        [[nodiscard]] friend constexpr EnumSet operator|(EnumSet a, const EnumSet &b) {return a |= b;}
+        [[nodiscard]] friend constexpr EnumSet operator&(EnumSet a, const EnumSet &b) {return a &= b;}
+        [[nodiscard]] friend constexpr EnumSet operator^(EnumSet a, const EnumSet &b) {return a ^= b;}
+        [[nodiscard]] friend constexpr EnumSet operator-(EnumSet a, const EnumSet &b) {return a -= b;}
+
+        // The complement, relative to `L`.
+        [[nodiscard]] constexpr EnumSet operator~() const
+        {
+            return All() -= *this;
+        }
+
+        [[nodiscard]] friend constexpr bool operator==(const EnumSet &, const EnumSet &) = default;
+
+        // Iterates over the values in the order of `L`.
+        class iterator
+        {
+            const EnumSet *set = nullptr;
+            std::size_t pos = 0;
+
+            friend EnumSet;
+            constexpr iterator(const EnumSet *set, std::size_t pos) : set(set), pos(pos) {}
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = E;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = E;
+
+            constexpr iterator() {}
+
+            [[nodiscard]] constexpr E operator*() const {return Indexer::values[pos];}
+
+            constexpr iterator &operator++()
+            {
+                pos = set->FindNext(pos + 1);
+                return *this;
+            }
+            constexpr iterator operator++(int)
+            {
+                iterator ret = *this;
+                ++*this;
+                return ret;
+            }
+
+            [[nodiscard]] friend constexpr bool operator==(const iterator &a, const iterator &b) {return a.pos == b.pos;}
+        };
+
+        [[nodiscard]] constexpr iterator begin() const {return iterator(this, FindNext(0));}
+        [[nodiscard]] constexpr iterator end() const {return iterator(this, capacity);}
+
+      private:
+        // Returns the first set bit at or after `i`, or `capacity` if none.
+        [[nodiscard]] constexpr std::size_t FindNext(std::size_t i) const
+        {
+            if (i >= capacity)
+                return capacity;
+
+            std::size_t word_index = i / 64;
+            std::uint64_t word = words[word_index] & (std::uint64_t(-1) << (i % 64));
+            while (word == 0)
+            {
+                if (++word_index == num_words)
+                    return capacity;
+                word = words[word_index];
+            }
+            return word_index * 64 + std::size_t(std::countr_zero(word));
+        }
+    };
+
+    // An array with one element per enumerator.
+    // `L` is a `ValueList` of the keys, by default all enumerators found by reflection.
+    // This is an aggregate, the elements are stored in the order of `L`.
+    template <typename E, typename T, typename L = enum_values<E>>
+    struct EnumArray
+    {
+      private:
+        using Indexer = detail::EnumContainers::Indexer<E, L>;
+
+      public:
+        using key_type = E;
+        using value_type = T;
+        using values = L;
+
+        static constexpr std::size_t size = Indexer::size;
+
+        std::array<T, size> elems{};
+
+        // Whether the key is in `L`.
+        [[nodiscard]] static constexpr bool HasKey(E key) {return Indexer::IndexOf(key) < size;}
+
+        // The key of the element at the index.
+        [[nodiscard]] static constexpr E KeyAt(std::size_t i) {return Indexer::values[i];}
+
+        // The key must be in `L`, this isn't checked.
+        [[nodiscard]] constexpr       T &operator[](E key)       {return elems[Indexer::IndexOf(key)];}
+        [[nodiscard]] constexpr const T &operator[](E key) const {return elems[Indexer::IndexOf(key)];}
+
+        // Returns null if the key isn't in `L`.
+        [[nodiscard]] constexpr T *Find(E key)
+        {
+            std::size_t i = Indexer::IndexOf(key);
+            return i < size ? &elems[i] : nullptr;
+        }
+        [[nodiscard]] constexpr const T *Find(E key) const
+        {
+            std::size_t i = Indexer::IndexOf(key);
+            return i < size ? &elems[i] : nullptr;
+        }
+
+        [[nodiscard]] constexpr auto begin()       {return elems.begin();}
+        [[nodiscard]] constexpr auto begin() const {return elems.begin();}
+        [[nodiscard]] constexpr auto end()       {return elems.end();}
+        [[nodiscard]] constexpr auto end() const {return elems.end();}
+
+        [[nodiscard]] friend constexpr bool operator==(const EnumArray &, const EnumArray &) = default;
+    };
+}
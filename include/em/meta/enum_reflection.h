@@ -0,0 +1,236 @@
+#pragma once
+
+#include "em/meta/lists.h"
+#include "em/meta/perfect_hash.h"
+#include "em/zstring_view.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Enum reflection: the list of enumerators and their names, discovered at compile-time.
+// This instantiates a function template for each value in a bounded range (see `enum_reflection_min` and `enum_reflection_max`),
+//   and checks if the compiler prints that value as a name or as a number. The values outside of the range are not found.
+// All tables are constexpr variables, there's no static initialization.
+
+namespace em::Meta
+{
+    // Enums that can be reflected. They must have a fixed underlying type (scoped enums always do),
+    //   because casting an out-of-range integer to an enum without one isn't a constant expression.
+    template <typename E>
+    concept reflectable_enum = std::is_enum_v<E> && requires{E{std::underlying_type_t<E>{}};};
+
+    // The range of values that's checked for enumerators. Specialize those to change the range.
+    // Keep the range small, since each value costs a template instantiation.
+    template <reflectable_enum E>
+    constexpr std::int64_t enum_reflection_min = std::max(std::int64_t(-128), std::int64_t(std::numeric_limits<std::underlying_type_t<E>>::min()));
+    template <reflectable_enum E>
+    constexpr std::int64_t enum_reflection_max = std::int64_t(std::min(std::uint64_t(127), std::uint64_t(std::numeric_limits<std::underlying_type_t<E>>::max())));
+
+    namespace detail::EnumReflection
+    {
+        template <auto V>
+        [[nodiscard]] consteval std::string_view RawValueName()
+        {
+            #ifdef _MSC_VER
+            return __FUNCSIG__;
+            #else
+            return __PRETTY_FUNCTION__;
+            #endif
+        }
+
+        // Extracts the unqualified enumerator name from the output of `RawValueName()`, or returns an empty string if the value isn't an enumerator.
+        // The compilers print the values without names as casts, e.g. `(E)5`, and those are rejected after stripping everything up to the `)`.
+        // Note that the qualifiers themselves can contain parentheses, e.g. Clang prints `(anonymous namespace)::E::name`.
+        [[nodiscard]] consteval std::string_view ExtractName(std::string_view raw)
+        {
+            #ifdef _MSC_VER
+            // `... RawValueName<E::name>(void)`.
+            std::size_t begin = raw.find("RawValueName<") + 13;
+            std::size_t end = raw.rfind(">(void)");
+            #else
+            // GCC: `... [with auto V = E::name; std::string_view = ...]`, Clang: `... [V = E::name]`.
+            std::size_t begin = raw.find("V = ") + 4;
+            std::size_t end = raw.find_first_of(";]", begin);
+            #endif
+            std::string_view name = raw.substr(begin, end - begin);
+
+            std::size_t sep = name.find_last_of(":)");
+            if (sep != std::string_view::npos)
+                name.remove_prefix(sep + 1);
+
+            if (name.empty() || name[0] == '-' || (name[0] >= '0' && name[0] <= '9'))
+                return {};
+            return name;
+        }
+
+        template <typename E>
+        [[nodiscard]] constexpr E FromInteger(std::int64_t value)
+        {
+            return E(std::underlying_type_t<E>(value));
+        }
+
+        template <typename E>
+        constexpr std::size_t range_size = std::size_t(enum_reflection_max<E> - enum_reflection_min<E> + 1);
+
+        // Which values in the range are enumerators.
+        template <typename E, std::size_t ...I>
+        [[nodiscard]] consteval std::array<bool, sizeof...(I)> FindEnumerators(std::index_sequence<I...>)
+        {
+            return {!ExtractName(RawValueName<FromInteger<E>(enum_reflection_min<E> + std::int64_t(I))>()).empty()...};
+        }
+
+        template <typename E>
+        constexpr std::array<bool, range_size<E>> is_enumerator = FindEnumerators<E>(std::make_index_sequence<range_size<E>>{});
+
+        template <typename E>
+        constexpr std::size_t num_enumerators = std::size_t(std::count(is_enumerator<E>.begin(), is_enumerator<E>.end(), true));
+
+        // The enumerators, sorted by value.
+        template <typename E>
+        constexpr std::array<E, num_enumerators<E>> values = []{
+            std::array<E, num_enumerators<E>> ret{};
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < range_size<E>; i++)
+            {
+                if (is_enumerator<E>[i])
+                    ret[pos++] = FromInteger<E>(enum_reflection_min<E> + std::int64_t(i));
+            }
+            return ret;
+        }();
+
+        template <typename E, typename I> struct MakeValueList {};
+        template <typename E, std::size_t ...I> struct MakeValueList<E, std::index_sequence<I...>> {using type = ValueList<values<E>[I]...>;};
+
+        template <typename E, std::size_t ...I>
+        [[nodiscard]] consteval std::size_t TotalNameLength(std::index_sequence<I...>)
+        {
+            return (ExtractName(RawValueName<values<E>[I]>()).size() + ... + 0);
+        }
+
+        // All names in one buffer, each followed by a null-terminator.
+        template <std::size_t N, std::size_t TotalLength>
+        struct NameBuffer
+        {
+            std::array<char, TotalLength + N> chars{};
+            // The name `i` starts at `offsets[i]` and ends at `offsets[i+1] - 1`.
+            std::array<std::uint32_t, N + 1> offsets{};
+        };
+
+        template <typename E, std::size_t ...I>
+        [[nodiscard]] consteval auto MakeNameBuffer(std::index_sequence<I...>)
+        {
+            NameBuffer<sizeof...(I), TotalNameLength<E>(std::index_sequence<I...>{})> ret;
+            std::size_t pos = 0;
+            std::size_t i = 0;
+            ([&]{
+                ret.offsets[i++] = std::uint32_t(pos);
+                for (char ch : ExtractName(RawValueName<values<E>[I]>()))
+                    ret.chars[pos++] = ch;
+                ret.chars[pos++] = '\0';
+            }(), ...);
+            ret.offsets[i] = std::uint32_t(pos);
+            return ret;
+        }
+
+        template <typename E>
+        constexpr auto name_buffer = MakeNameBuffer<E>(std::make_index_sequence<num_enumerators<E>>{});
+
+        template <typename E>
+        constexpr std::array<zstring_view, num_enumerators<E>> names = []{
+            std::array<zstring_view, num_enumerators<E>> ret;
+            for (std::size_t i = 0; i < ret.size(); i++)
+            {
+                const char *begin = name_buffer<E>.chars.data() + name_buffer<E>.offsets[i];
+                const char *end = name_buffer<E>.chars.data() + name_buffer<E>.offsets[i + 1] - 1;
+                ret[i] = zstring_view(zstring_view::TrustNullTerminated{}, std::string_view(begin, end));
+            }
+            return ret;
+        }();
+
+        template <typename E>
+        constexpr PerfectStringHash<num_enumerators<E>> name_hash = []{
+            std::array<std::string_view, num_enumerators<E>> ret;
+            for (std::size_t i = 0; i < ret.size(); i++)
+                ret[i] = names<E>[i];
+            return ret;
+        }();
+
+        // Maps `value - values<E>.front()` to the enumerator index, or `num_enumerators<E>` for the holes.
+        template <typename E>
+        constexpr auto dense_indices = []{
+            using index_t = std::conditional_t<(num_enumerators<E> < 0xff), std::uint8_t, std::uint16_t>;
+            if constexpr (num_enumerators<E> == 0)
+            {
+                return std::array<index_t, 0>{};
+            }
+            else
+            {
+                constexpr std::int64_t first = std::int64_t(values<E>.front());
+                constexpr std::int64_t last = std::int64_t(values<E>.back());
+                std::array<index_t, std::size_t(last - first + 1)> ret{};
+                std::fill(ret.begin(), ret.end(), index_t(num_enumerators<E>));
+                for (std::size_t i = 0; i < num_enumerators<E>; i++)
+                    ret[std::size_t(std::int64_t(values<E>[i]) - first)] = index_t(i);
+                return ret;
+            }
+        }();
+    }
+
+    // The number of enumerators found in `E`.
+    template <reflectable_enum E>
+    constexpr std::size_t enum_size = detail::EnumReflection::num_enumerators<E>;
+
+    // All enumerators of `E` sorted by value, with no duplicates (of several enumerators with the same value, only one is listed).
+    template <reflectable_enum E>
+    using enum_values = typename detail::EnumReflection::MakeValueList<E, std::make_index_sequence<enum_size<E>>>::type;
+
+    // Same as `enum_values`, but as an array.
+    template <reflectable_enum E>
+    constexpr const std::array<E, enum_size<E>> &enum_value_array = detail::EnumReflection::values<E>;
+
+    // Returns the position of the enumerator in `enum_values<E>`, or `enum_size<E>` if `value` isn't an enumerator. This is O(1).
+    template <reflectable_enum E>
+    [[nodiscard]] constexpr std::size_t EnumIndex(E value)
+    {
+        if constexpr (enum_size<E> == 0)
+        {
+            (void)value;
+            return 0;
+        }
+        else
+        {
+            // Using unsigned arithmetic to handle both the values before the first enumerator and the huge unsigned values.
+            const std::uint64_t offset = std::uint64_t(std::int64_t(value)) - std::uint64_t(std::int64_t(detail::EnumReflection::values<E>.front()));
+            if (offset >= detail::EnumReflection::dense_indices<E>.size())
+                return enum_size<E>;
+            return detail::EnumReflection::dense_indices<E>[offset];
+        }
+    }
+
+    // Returns the enumerator name without qualifiers, or an empty string if `value` isn't an enumerator. This is O(1).
+    template <reflectable_enum E>
+    [[nodiscard]] constexpr zstring_view EnumToString(E value)
+    {
+        std::size_t index = EnumIndex(value);
+        if (index == enum_size<E>)
+            return {};
+        return detail::EnumReflection::names<E>[index];
+    }
+
+    // Returns the enumerator with this name (without qualifiers), or null if none. This uses a perfect hash, so it's O(length of `name`).
+    template <reflectable_enum E>
+    [[nodiscard]] constexpr std::optional<E> EnumFromString(std::string_view name)
+    {
+        std::size_t index = detail::EnumReflection::name_hash<E>.Find(name);
+        if (index == enum_size<E>)
+            return std::nullopt;
+        return detail::EnumReflection::values<E>[index];
+    }
+}
@@ -5,8 +5,11 @@
 #include "em/macros/utils/returns.h"
 #include "em/meta/common.h"
 
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace em::Meta
 {
@@ -65,6 +68,107 @@ namespace em::Meta
     [[nodiscard]] constexpr auto MakeNegatedFuncRef(auto &&func) EM_RETURNS(std::not_fn(FuncRef(EM_FWD(func))))
 
 
+    template <typename Signature>
+    class FunctionRef;
+
+    namespace detail::Functional
+    {
+        // Given a callable `F &&` passed to `FunctionRef`, returns the referenced object and the type it should be called as.
+        // Plain callables are called as lvalues, since a `FunctionRef` can be called more than once.
+        template <typename F>
+        struct FunctionRefTarget
+        {
+            using type = std::remove_reference_t<F> &;
+            [[nodiscard]] static constexpr auto &Get(F &&func) noexcept {return func;}
+        };
+        // `FuncRef`s are unwrapped instead of adding another indirection, and their referents are called the same way `FuncRef::operator()` would call them.
+        template <typename F> requires specialization_of_ignoring_cvref<F, FuncRef>
+        struct FunctionRefTarget<F>
+        {
+            using type = decltype((combine_forwarding<F>)(std::declval<decltype(std::remove_cvref_t<F>::ref)>()));
+            [[nodiscard]] static constexpr auto &Get(F &&func) noexcept {return func.ref;}
+        };
+
+        // If `F` is a function or a function pointer (ignoring cvref), returns the function type. Otherwise returns `void`.
+        template <typename F>
+        using FunctionRefFuncType = std::conditional_t<std::is_function_v<std::remove_pointer_t<std::remove_cvref_t<F>>>, std::remove_pointer_t<std::remove_cvref_t<F>>, void>;
+
+        template <typename Self, bool Noexcept, typename R, typename ...P>
+        class BasicFunctionRef
+        {
+            union Storage
+            {
+                void *object;
+                void (*func)();
+            };
+
+            Storage storage;
+            R (*trampoline)(Storage, P &&...) noexcept(Noexcept);
+
+            template <typename CallType>
+            static constexpr R CallObject(Storage data, P &&... params) noexcept(Noexcept)
+            {
+                return std::invoke_r<R>(static_cast<CallType>(*static_cast<std::remove_reference_t<CallType> *>(data.object)), std::forward<P>(params)...);
+            }
+
+            template <typename FuncType>
+            static R CallFunc(Storage data, P &&... params) noexcept(Noexcept)
+            {
+                return std::invoke_r<R>(reinterpret_cast<FuncType *>(data.func), std::forward<P>(params)...);
+            }
+
+          public:
+            // Stores a reference to `func`. Temporaries are accepted, but then this must not outlive the full-expression, as usual for function parameters.
+            // Function pointers are stored by value, and must not be null.
+            template <typename F>
+            requires
+                (!std::is_same_v<std::remove_cvref_t<F>, Self>) && // Don't wrap ourselves, use the copy constructor.
+                (Noexcept ? std::is_nothrow_invocable_r_v<R, typename FunctionRefTarget<F>::type, P...> : std::is_invocable_r_v<R, typename FunctionRefTarget<F>::type, P...>)
+            constexpr BasicFunctionRef(F &&func) noexcept
+            {
+                using Target = FunctionRefTarget<F>;
+                using FuncType = FunctionRefFuncType<typename Target::type>;
+
+                if constexpr (std::is_void_v<FuncType>)
+                {
+                    storage.object = const_cast<void *>(static_cast<const void *>(std::addressof(Target::Get(EM_FWD(func)))));
+                    trampoline = CallObject<typename Target::type>;
+                }
+                else
+                {
+                    storage.func = reinterpret_cast<void (*)()>(static_cast<FuncType *>(Target::Get(EM_FWD(func))));
+                    trampoline = CallFunc<FuncType>;
+                }
+            }
+
+            // This is `const` because it doesn't modify the reference itself. The referenced callable can still be non-const.
+            constexpr R operator()(P... params) const noexcept(Noexcept)
+            {
+                return trampoline(storage, std::forward<P>(params)...);
+            }
+        };
+    }
+
+    // A non-owning type-erased reference to a callable, like `std::function_ref`. Unlike `FuncRef`, the type doesn't depend on the callable.
+    // This is two pointers (the object or function pointer, and the function that calls it), and is trivially copyable. It never allocates.
+    // `Signature` is `R(P...)` or `R(P...) noexcept`.
+    template <typename R, typename ...P>
+    class FunctionRef<R(P...)> : public detail::Functional::BasicFunctionRef<FunctionRef<R(P...)>, false, R, P...>
+    {
+        using detail::Functional::BasicFunctionRef<FunctionRef<R(P...)>, false, R, P...>::BasicFunctionRef;
+    };
+    template <typename R, typename ...P>
+    class FunctionRef<R(P...) noexcept> : public detail::Functional::BasicFunctionRef<FunctionRef<R(P...) noexcept>, true, R, P...>
+    {
+        using detail::Functional::BasicFunctionRef<FunctionRef<R(P...) noexcept>, true, R, P...>::BasicFunctionRef;
+    };
+
+    template <typename R, typename ...P>
+    FunctionRef(R (*)(P...)) -> FunctionRef<R(P...)>;
+    template <typename R, typename ...P>
+    FunctionRef(R (*)(P...) noexcept) -> FunctionRef<R(P...) noexcept>;
+
+
     namespace detail::Functional
     {
         // Not using the base template, because we need different `requires` on both specializations,
@@ -81,6 +185,86 @@ namespace em::Meta
         struct FoldIsNoexcept : std::is_nothrow_invocable<F &&, A &&, B &&> {};
         template <typename F, typename A, typename B, typename C, typename ...D>
         struct FoldIsNoexcept<F, A, B, C, D...> : std::is_nothrow_invocable<F &&, A &&, typename FoldReturnType<F, B, C, D...>::type> {};
+
+
+        // The type of the functor for the inner calls, which aren't allowed to forward it.
+        template <typename F>
+        using FoldInnerFunc = std::remove_reference_t<F> &;
+
+
+        // For `FoldBalanced()`. Here `Outer` is false for the inner calls. A single argument is returned by reference as is.
+        template <bool Outer, typename F, typename ...P>
+        struct FoldBalancedResult {};
+
+        template <bool Outer, typename F, typename I, typename J, typename ...P>
+        struct FoldBalancedHalves {};
+
+        template <bool Outer, typename F, std::size_t ...I, std::size_t ...J, typename ...P>
+        requires std::is_invocable_v<std::conditional_t<Outer, F &&, FoldInnerFunc<F>>, typename FoldBalancedResult<false, F, P...[I]...>::type, typename FoldBalancedResult<false, F, P...[sizeof...(I) + J]...>::type>
+        struct FoldBalancedHalves<Outer, F, std::index_sequence<I...>, std::index_sequence<J...>, P...>
+        {
+            using func_type = std::conditional_t<Outer, F &&, FoldInnerFunc<F>>;
+            using type = std::invoke_result_t<func_type, typename FoldBalancedResult<false, F, P...[I]...>::type, typename FoldBalancedResult<false, F, P...[sizeof...(I) + J]...>::type>;
+            static constexpr bool is_noexcept =
+                FoldBalancedResult<false, F, P...[I]...>::is_noexcept &&
+                FoldBalancedResult<false, F, P...[sizeof...(I) + J]...>::is_noexcept &&
+                std::is_nothrow_invocable_v<func_type, typename FoldBalancedResult<false, F, P...[I]...>::type, typename FoldBalancedResult<false, F, P...[sizeof...(I) + J]...>::type>;
+        };
+
+        template <bool Outer, typename F, typename P0>
+        struct FoldBalancedResult<Outer, F, P0>
+        {
+            using type = P0 &&;
+            static constexpr bool is_noexcept = true;
+        };
+
+        template <bool Outer, typename F, typename P0, typename P1, typename ...P>
+        requires requires{typename FoldBalancedHalves<Outer, F, std::make_index_sequence<(sizeof...(P) + 2) / 2>, std::make_index_sequence<(sizeof...(P) + 3) / 2>, P0, P1, P...>::type;}
+        struct FoldBalancedResult<Outer, F, P0, P1, P...> : FoldBalancedHalves<Outer, F, std::make_index_sequence<(sizeof...(P) + 2) / 2>, std::make_index_sequence<(sizeof...(P) + 3) / 2>, P0, P1, P...> {};
+
+        [[nodiscard]] EM_TINY constexpr decltype(auto) FoldBalancedLow(auto &&func, auto &&... args)
+        {
+            if constexpr (sizeof...(args) == 1)
+            {
+                return EM_FWD(args...[0]);
+            }
+            else
+            {
+                return [&]<std::size_t ...I, std::size_t ...J>(std::index_sequence<I...>, std::index_sequence<J...>) -> decltype(auto)
+                {
+                    // Only the outermost call forwards `func`, same as in `Fold()`.
+                    return std::invoke(EM_FWD(func), (FoldBalancedLow)(func, EM_FWD(args...[I])...), (FoldBalancedLow)(func, EM_FWD(args...[sizeof...(I) + J])...));
+                }(std::make_index_sequence<sizeof...(args) / 2>{}, std::make_index_sequence<(sizeof...(args) + 1) / 2>{});
+            }
+        }
+
+
+        // For `FoldLeft()`. The outermost call is the last one, and only it gets to forward the functor.
+        template <typename F, typename A, typename B, typename ...C>
+        struct FoldLeftResult {};
+
+        template <typename F, typename A, typename B> requires std::is_invocable_v<F &&, A &&, B &&>
+        struct FoldLeftResult<F, A, B>
+        {
+            using type = std::invoke_result_t<F &&, A &&, B &&>;
+            static constexpr bool is_noexcept = std::is_nothrow_invocable_v<F &&, A &&, B &&>;
+        };
+
+        template <typename F, typename A, typename B, typename C, typename ...D>
+        requires std::is_invocable_v<FoldInnerFunc<F>, A &&, B &&> && requires{typename FoldLeftResult<F, std::invoke_result_t<FoldInnerFunc<F>, A &&, B &&>, C, D...>::type;}
+        struct FoldLeftResult<F, A, B, C, D...>
+        {
+            using type = typename FoldLeftResult<F, std::invoke_result_t<FoldInnerFunc<F>, A &&, B &&>, C, D...>::type;
+            static constexpr bool is_noexcept = std::is_nothrow_invocable_v<FoldInnerFunc<F>, A &&, B &&> && FoldLeftResult<F, std::invoke_result_t<FoldInnerFunc<F>, A &&, B &&>, C, D...>::is_noexcept;
+        };
+
+        [[nodiscard]] EM_TINY constexpr decltype(auto) FoldLeftLow(auto &&func, auto &&a, auto &&b, auto &&... c)
+        {
+            if constexpr (sizeof...(c) == 0)
+                return std::invoke(EM_FWD(func), EM_FWD(a), EM_FWD(b));
+            else
+                return (FoldLeftLow)(EM_FWD(func), std::invoke(func, EM_FWD(a), EM_FWD(b)), EM_FWD(c)...);
+        }
     }
 
 
@@ -103,4 +287,21 @@ namespace em::Meta
         // So lets use that.
         return std::invoke(EM_FWD(func), EM_FWD(a), (Fold)(func, EM_FWD(b), EM_FWD(c), EM_FWD(d)...));
     }
+
+    // Same as `Fold()`, but reduces pairwise: `f(f(a, b), f(c, d))`. The result only matches `Fold()` if `func` is associative.
+    // The calls on the two halves don't depend on each other, so the CPU can run them in parallel, and the instantiation depth is O(log N).
+    [[nodiscard]] EM_TINY constexpr auto FoldBalanced(auto &&func, auto &&a, auto &&b, auto &&... c)
+        noexcept(detail::Functional::FoldBalancedResult<true, decltype(func), decltype(a), decltype(b), decltype(c)...>::is_noexcept)
+        -> typename detail::Functional::FoldBalancedResult<true, decltype(func), decltype(a), decltype(b), decltype(c)...>::type
+    {
+        return detail::Functional::FoldBalancedLow(EM_FWD(func), EM_FWD(a), EM_FWD(b), EM_FWD(c)...);
+    }
+
+    // Same as `Fold()`, but folds left: `f(f(f(a, b), c), d)`.
+    [[nodiscard]] EM_TINY constexpr auto FoldLeft(auto &&func, auto &&a, auto &&b, auto &&... c)
+        noexcept(detail::Functional::FoldLeftResult<decltype(func), decltype(a), decltype(b), decltype(c)...>::is_noexcept)
+        -> typename detail::Functional::FoldLeftResult<decltype(func), decltype(a), decltype(b), decltype(c)...>::type
+    {
+        return detail::Functional::FoldLeftLow(EM_FWD(func), EM_FWD(a), EM_FWD(b), EM_FWD(c)...);
+    }
 }
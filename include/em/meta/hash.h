@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Constexpr hashing helpers.
+
+namespace em::Meta
+{
+    // FNV-1a, with an optional seed mixed into the initial state.
+    // This is not cryptographically secure and not stable between versions of this library, don't store the hashes persistently.
+    [[nodiscard]] constexpr std::uint64_t HashString(std::string_view str, std::uint64_t seed = 0) noexcept
+    {
+        std::uint64_t ret = 0xcbf29ce484222325 ^ (seed * 0x9e3779b97f4a7c15);
+        for (char ch : str)
+        {
+            ret ^= (unsigned char)ch;
+            ret *= 0x100000001b3;
+        }
+        return ret;
+    }
+
+    // Combines two hashes. The order of the arguments matters.
+    [[nodiscard]] constexpr std::uint64_t HashCombine(std::uint64_t a, std::uint64_t b) noexcept
+    {
+        return a ^ (b + 0x9e3779b97f4a7c15 + (a << 6) + (a >> 2));
+    }
+}
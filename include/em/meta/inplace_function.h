@@ -0,0 +1,166 @@
+#pragma once
+
+#include "em/macros/utils/forward.h"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// An owning type-erased callable with a fixed inline buffer. Unlike `std::function`, this never allocates.
+
+namespace em::Meta
+{
+    template <typename Signature, std::size_t Capacity = sizeof(void *) * 4, std::size_t Alignment = alignof(std::max_align_t)>
+    class InplaceFunction;
+
+    namespace detail::InplaceFunction
+    {
+        // The non-trivial operations on a stored callable.
+        // Trivially copyable callables don't get those, they are relocated with `memcpy()` and are never destroyed.
+        struct Ops
+        {
+            // Move-constructs the callable at `to` from `from`, then destroys `from`.
+            void (*relocate)(void *to, void *from) noexcept = nullptr;
+            void (*destroy)(void *target) noexcept = nullptr;
+        };
+
+        template <typename F>
+        inline constexpr Ops ops_for = {
+            .relocate = [](void *to, void *from) noexcept
+            {
+                F &source = *std::launder(static_cast<F *>(from));
+                ::new(to) F(std::move(source));
+                source.~F();
+            },
+            .destroy = [](void *target) noexcept
+            {
+                std::launder(static_cast<F *>(target))->~F();
+            },
+        };
+
+        template <typename Self, std::size_t Capacity, std::size_t Alignment, bool Noexcept, typename R, typename ...P>
+        class BasicInplaceFunction
+        {
+            alignas(Alignment) std::byte buffer[Capacity];
+            // Null if empty.
+            R (*invoker)(void *, P &&...) noexcept(Noexcept) = nullptr;
+            // Null if empty or if the callable is trivially copyable.
+            const Ops *ops = nullptr;
+
+            template <typename F>
+            static R Invoke(void *target, P &&... params) noexcept(Noexcept)
+            {
+                return std::invoke_r<R>(*std::launder(static_cast<F *>(target)), std::forward<P>(params)...);
+            }
+
+            void Reset() noexcept
+            {
+                if (ops)
+                    ops->destroy(buffer);
+                invoker = nullptr;
+                ops = nullptr;
+            }
+
+            // Assumes we're empty. Leaves `other` empty.
+            void TakeFrom(BasicInplaceFunction &other) noexcept
+            {
+                if (other.ops)
+                    other.ops->relocate(buffer, other.buffer);
+                else if (other.invoker)
+                    std::memcpy(buffer, other.buffer, Capacity); // Copying the whole buffer is cheaper than looking up the actual size.
+
+                invoker = other.invoker;
+                ops = other.ops;
+                other.invoker = nullptr;
+                other.ops = nullptr;
+            }
+
+          public:
+            static constexpr std::size_t capacity = Capacity;
+            static constexpr std::size_t alignment = Alignment;
+
+            // Whether a callable of type `F` fits into the buffer.
+            template <typename F>
+            static constexpr bool fits = sizeof(F) <= Capacity && alignof(F) <= Alignment;
+
+            // Constructs an empty function.
+            BasicInplaceFunction() noexcept {}
+            BasicInplaceFunction(std::nullptr_t) noexcept {}
+
+            // Stores a copy of `func`. Null function pointers produce an empty function.
+            // The callable must fit into the buffer (see `fits`), and must be nothrow move-constructible, because we relocate it on moves.
+            template <typename F>
+            requires
+                (!std::is_same_v<std::remove_cvref_t<F>, Self>) && // Use the move constructor instead.
+                std::is_constructible_v<std::decay_t<F>, F &&> &&
+                fits<std::decay_t<F>> &&
+                std::is_nothrow_move_constructible_v<std::decay_t<F>> &&
+                (Noexcept ? std::is_nothrow_invocable_r_v<R, std::decay_t<F> &, P...> : std::is_invocable_r_v<R, std::decay_t<F> &, P...>)
+            BasicInplaceFunction(F &&func) noexcept(std::is_nothrow_constructible_v<std::decay_t<F>, F &&>)
+            {
+                using Func = std::decay_t<F>;
+
+                if constexpr (std::is_pointer_v<Func> || std::is_member_pointer_v<Func>)
+                {
+                    if (!func)
+                        return;
+                }
+
+                ::new((void *)buffer) Func(EM_FWD(func));
+                invoker = Invoke<Func>;
+                if constexpr (!std::is_trivially_copyable_v<Func>)
+                    ops = &ops_for<Func>;
+            }
+
+            // Like `ZeroMovedFrom`, moving leaves the source empty.
+            BasicInplaceFunction(BasicInplaceFunction &&other) noexcept
+            {
+                TakeFrom(other);
+            }
+            BasicInplaceFunction &operator=(BasicInplaceFunction &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    Reset();
+                    TakeFrom(other);
+                }
+                return *this;
+            }
+
+            ~BasicInplaceFunction()
+            {
+                Reset();
+            }
+
+            [[nodiscard]] explicit operator bool() const noexcept {return bool(invoker);}
+
+            // The function must not be empty.
+            // This is non-const, because the stored callable is called as a non-const lvalue.
+            R operator()(P... params) noexcept(Noexcept)
+            {
+                return invoker(buffer, std::forward<P>(params)...);
+            }
+        };
+    }
+
+    // An owning type-erased callable, stored in a fixed buffer of `Capacity` bytes aligned to `Alignment`. This never allocates,
+    //   and callables that don't fit are rejected at compile-time.
+    // `Signature` is `R(P...)` or `R(P...) noexcept`.
+    // This is move-only, and the callables must be nothrow move-constructible.
+    // Trivially copyable callables are moved with a single `memcpy()` of the buffer, without any indirect calls.
+    template <typename R, std::size_t Capacity, std::size_t Alignment, typename ...P>
+    class InplaceFunction<R(P...), Capacity, Alignment>
+        : public detail::InplaceFunction::BasicInplaceFunction<InplaceFunction<R(P...), Capacity, Alignment>, Capacity, Alignment, false, R, P...>
+    {
+        using detail::InplaceFunction::BasicInplaceFunction<InplaceFunction<R(P...), Capacity, Alignment>, Capacity, Alignment, false, R, P...>::BasicInplaceFunction;
+    };
+    template <typename R, std::size_t Capacity, std::size_t Alignment, typename ...P>
+    class InplaceFunction<R(P...) noexcept, Capacity, Alignment>
+        : public detail::InplaceFunction::BasicInplaceFunction<InplaceFunction<R(P...) noexcept, Capacity, Alignment>, Capacity, Alignment, true, R, P...>
+    {
+        using detail::InplaceFunction::BasicInplaceFunction<InplaceFunction<R(P...) noexcept, Capacity, Alignment>, Capacity, Alignment, true, R, P...>::BasicInplaceFunction;
+    };
+}
@@ -1,5 +1,13 @@
 #pragma once
 
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/lists.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 namespace em::Meta
 {
     template <typename ...P>
@@ -10,4 +18,60 @@ namespace em::Meta
 
     template <typename ...P>
     Overload(P...) -> Overload<P...>;
+
+
+    namespace detail::Overload
+    {
+        // Given a member pointer to `operator()` with a single parameter, returns the parameter type.
+        template <typename T> struct SingleParam {};
+        template <typename R, typename C, typename A> struct SingleParam<R (C::*)(A)                > {using type = A;};
+        template <typename R, typename C, typename A> struct SingleParam<R (C::*)(A) noexcept       > {using type = A;};
+        template <typename R, typename C, typename A> struct SingleParam<R (C::*)(A) const          > {using type = A;};
+        template <typename R, typename C, typename A> struct SingleParam<R (C::*)(A) const noexcept > {using type = A;};
+        template <typename R, typename A>             struct SingleParam<R (*)(A)                   > {using type = A;}; // Static `operator()`.
+        template <typename R, typename A>             struct SingleParam<R (*)(A) noexcept          > {using type = A;}; // ^
+
+        // The parameter type of a functor with a single non-template `operator()`, without cvref-qualifiers.
+        template <typename F>
+        using single_param_type = std::remove_cvref_t<typename SingleParam<decltype(&F::operator())>::type>;
+
+        // Maps types to indices. Looking up the index is a single derived-to-base deduction, which doesn't depend on the number of entries.
+        template <typename T, std::size_t I> struct IndexEntry {};
+
+        template <typename T, typename I> struct IndexMap {};
+        template <typename ...T, std::size_t ...I> struct IndexMap<TypeList<T...>, std::index_sequence<I...>> : IndexEntry<T, I>... {};
+
+        template <typename T, std::size_t I>
+        constexpr std::size_t LookupIndex(const IndexEntry<T, I> *) {return I;}
+    }
+
+    // Like `Overload`, but each functor must have a single non-template `operator()` with one parameter, and those parameter types must be distinct
+    //   (ignoring cvref-qualifiers). Instead of overload resolution over all functors, the argument type is looked up in a type-to-index map,
+    //   and the matching functor is called directly. This compiles much faster for large numbers of functors.
+    // The argument type must match one of the parameter types exactly (ignoring cvref-qualifiers), no implicit conversions are considered.
+    template <typename ...P>
+    struct OverloadByType : P...
+    {
+        // The parameter types, without cvref-qualifiers.
+        using param_types = TypeList<detail::Overload::single_param_type<P>...>;
+
+        using index_map = detail::Overload::IndexMap<param_types, std::index_sequence_for<P...>>;
+        // If a type is repeated, the lookup is ambiguous and fails.
+        static_assert((requires{detail::Overload::LookupIndex<detail::Overload::single_param_type<P>>((index_map *)nullptr);} && ...), "The parameter types must be distinct.");
+
+        // If `T` (ignoring cvref) is a parameter type, returns the index of its functor.
+        template <typename T>
+        requires requires{detail::Overload::LookupIndex<std::remove_cvref_t<T>>((index_map *)nullptr);}
+        static constexpr std::size_t index_of = detail::Overload::LookupIndex<std::remove_cvref_t<T>>((index_map *)nullptr);
+
+        template <typename Self, typename T>
+        requires requires{index_of<T>;} && std::is_invocable_v<copy_cvref<Self &&, P...[index_of<T>]>, T &&>
+        constexpr decltype(auto) operator()(this Self &&self, T &&arg)
+        {
+            return static_cast<copy_cvref<Self &&, P...[index_of<T>]>>(self)(EM_FWD(arg));
+        }
+    };
+
+    template <typename ...P>
+    OverloadByType(P...) -> OverloadByType<P...>;
 }
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "em/meta/hash.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+// A minimal perfect hash over a fixed set of strings, constructed at compile-time.
+
+namespace em::Meta
+{
+    namespace detail::PerfectHash
+    {
+        // Derives a secondary hash from the primary one, so we only need to hash the string once per lookup.
+        [[nodiscard]] constexpr std::uint64_t Mix(std::uint64_t hash, std::uint32_t seed) noexcept
+        {
+            // The splitmix64 finalizer.
+            hash += seed * 0x9e3779b97f4a7c15;
+            hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+            hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+            return hash ^ (hash >> 31);
+        }
+
+        // If this bit is set in a bucket, the remaining bits are the slot index directly. Otherwise they are the seed for `Mix()`.
+        inline constexpr std::uint32_t direct_slot_bit = 0x80000000;
+    }
+
+    // Maps each of the `N` keys to a unique index in `0..N-1` (the key's position in the array), with O(1) lookup.
+    // This uses the "hash and displace" scheme: the keys are split into buckets by the hash,
+    //   and each bucket stores a seed that maps all its keys to free slots without collisions.
+    // The keys must be distinct, otherwise this fails to compile.
+    // The string views are stored as is, so they must point to static storage.
+    template <std::size_t N>
+    class PerfectStringHash
+    {
+        static constexpr std::size_t num_buckets = N > 0 ? N : 1;
+
+        std::array<std::string_view, N> keys{};
+        std::array<std::uint32_t, num_buckets> buckets{};
+        // Maps slots to key indices.
+        std::array<std::uint32_t, N> slots{};
+
+      public:
+        consteval PerfectStringHash(const std::array<std::string_view, N> &new_keys)
+            : keys(new_keys)
+        {
+            static_assert(N < detail::PerfectHash::direct_slot_bit, "Too many keys.");
+
+            std::array<std::uint64_t, N> hashes{};
+            for (std::size_t i = 0; i < N; i++)
+            {
+                hashes[i] = HashString(keys[i]);
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    if (hashes[i] == hashes[j])
+                        std::unreachable(); // Duplicate keys (or a 64-bit hash collision). This causes a compilation error.
+                }
+            }
+
+            // Sort the keys by bucket.
+            std::array<std::size_t, num_buckets + 1> bucket_begin{};
+            for (std::size_t i = 0; i < N; i++)
+                bucket_begin[hashes[i] % num_buckets + 1]++;
+            for (std::size_t i = 0; i < num_buckets; i++)
+                bucket_begin[i + 1] += bucket_begin[i];
+            std::array<std::size_t, N> keys_by_bucket{};
+            {
+                std::array<std::size_t, num_buckets> pos{};
+                for (std::size_t i = 0; i < N; i++)
+                {
+                    std::size_t bucket = hashes[i] % num_buckets;
+                    keys_by_bucket[bucket_begin[bucket] + pos[bucket]++] = i;
+                }
+            }
+
+            // Process the largest buckets first, while there are still many free slots.
+            std::array<std::size_t, num_buckets> bucket_order{};
+            for (std::size_t i = 0; i < num_buckets; i++)
+            {
+                std::size_t size = bucket_begin[i + 1] - bucket_begin[i];
+                std::size_t j = i;
+                while (j > 0 && bucket_begin[bucket_order[j - 1] + 1] - bucket_begin[bucket_order[j - 1]] < size)
+                {
+                    bucket_order[j] = bucket_order[j - 1];
+                    j--;
+                }
+                bucket_order[j] = i;
+            }
+
+            std::array<bool, N> slot_taken{};
+            std::size_t next_free_slot = 0;
+
+            for (std::size_t bucket : bucket_order)
+            {
+                const std::size_t begin = bucket_begin[bucket];
+                const std::size_t size = bucket_begin[bucket + 1] - begin;
+
+                if (size == 0)
+                    break; // The remaining buckets are empty too.
+
+                if (size == 1)
+                {
+                    // Don't need to search for a seed, just put the key into any free slot.
+                    while (slot_taken[next_free_slot])
+                        next_free_slot++;
+                    slot_taken[next_free_slot] = true;
+                    slots[next_free_slot] = std::uint32_t(keys_by_bucket[begin]);
+                    buckets[bucket] = detail::PerfectHash::direct_slot_bit | std::uint32_t(next_free_slot);
+                    continue;
+                }
+
+                for (std::uint32_t seed = 1;; seed++)
+                {
+                    if (seed == detail::PerfectHash::direct_slot_bit)
+                        std::unreachable(); // Failed to find a seed. This causes a compilation error.
+
+                    bool ok = true;
+                    for (std::size_t i = 0; ok && i < size; i++)
+                    {
+                        std::size_t slot = detail::PerfectHash::Mix(hashes[keys_by_bucket[begin + i]], seed) % N;
+                        if (slot_taken[slot])
+                        {
+                            ok = false;
+                            break;
+                        }
+                        // Check for collisions within the bucket.
+                        for (std::size_t j = 0; j < i; j++)
+                        {
+                            if (detail::PerfectHash::Mix(hashes[keys_by_bucket[begin + j]], seed) % N == slot)
+                            {
+                                ok = false;
+                                break;
+                            }
+                        }
+                    }
+                    if (!ok)
+                        continue;
+
+                    for (std::size_t i = 0; i < size; i++)
+                    {
+                        std::size_t slot = detail::PerfectHash::Mix(hashes[keys_by_bucket[begin + i]], seed) % N;
+                        slot_taken[slot] = true;
+                        slots[slot] = std::uint32_t(keys_by_bucket[begin + i]);
+                    }
+                    buckets[bucket] = seed;
+                    break;
+                }
+            }
+
+            // Verify the result.
+            for (std::size_t i = 0; i < N; i++)
+            {
+                if (Find(keys[i]) != i)
+                    std::unreachable(); // This causes a compilation error.
+            }
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const {return N;}
+
+        // Returns the key at the index.
+        [[nodiscard]] constexpr std::string_view operator[](std::size_t i) const {return keys[i];}
+
+        // Returns the index of the key, or `N` if it's not one of the keys.
+        // This hashes the string once, and does one final comparison.
+        [[nodiscard]] constexpr std::size_t Find(std::string_view key) const
+        {
+            if constexpr (N == 0)
+            {
+                (void)key;
+                return 0;
+            }
+            else
+            {
+                const std::uint64_t hash = HashString(key);
+                const std::uint32_t bucket = buckets[hash % num_buckets];
+                const std::size_t slot = bucket & detail::PerfectHash::direct_slot_bit ? bucket & ~detail::PerfectHash::direct_slot_bit : detail::PerfectHash::Mix(hash, bucket) % N;
+                const std::size_t ret = slots[slot];
+                return keys[ret] == key ? ret : N;
+            }
+        }
+    };
+}
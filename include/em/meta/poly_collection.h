@@ -0,0 +1,98 @@
+#pragma once
+
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/const_for.h"
+#include "em/meta/lists.h"
+#include "em/meta/tuple.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A collection of objects of several types derived from a common base, where each type is stored in its own contiguous segment.
+
+namespace em::Meta
+{
+    template <typename Base, typename L>
+    class PolyCollection
+    {
+        static_assert(always_false<Base, L>, "The second template argument must be a `TypeList<...>`.");
+    };
+
+    // Stores objects of types `D...` (which must be derived from `Base`, or be the same type) in one `std::vector` per type.
+    // Iterating visits the segments in order, and passes the objects to the functor with their exact types,
+    //   so the calls aren't virtual if the types (or the called member functions) are `final`, and can be inlined.
+    // Unlike a `std::vector<std::unique_ptr<Base>>`, there's no pointer to chase per element, and no per-element allocation.
+    // The order of insertion is only preserved within each type.
+    template <typename Base, typename ...D>
+    class PolyCollection<Base, TypeList<D...>>
+    {
+        static_assert(((cvref_unqualified<D> && same_or_derived_from<D, Base>) && ...), "The types must be cvref-unqualified and derived from the base.");
+        static_assert(list_size<list_uniq<TypeList<D...>>> == sizeof...(D), "The types must be distinct.");
+
+        Tuple<std::vector<D>...> segments;
+
+      public:
+        using base = Base;
+        using types = TypeList<D...>;
+
+        // The index of `T` in `types`.
+        template <typename T> requires list_contains_type<types, T>
+        static constexpr std::size_t index_of = list_find_type<types, T>::value;
+
+        // Returns the vector storing objects of type `T`.
+        // It's fine to modify it directly, e.g. to erase or reorder elements.
+        template <typename T, typename Self> requires requires{index_of<T>;}
+        [[nodiscard]] copy_cvref<Self &&, std::vector<T>> Segment(this Self &&self)
+        {
+            return EM_FWD(self).segments.template get<index_of<T>>();
+        }
+
+        // Adds an object of type `T`, returns a reference to it.
+        // This invalidates references to the other objects of the same type.
+        template <typename T, typename ...P> requires requires{index_of<T>;} && std::is_constructible_v<T, P &&...>
+        T &Emplace(P &&... params)
+        {
+            return Segment<T>().emplace_back(EM_FWD(params)...);
+        }
+        template <typename T> requires requires{index_of<std::remove_cvref_t<T>>;}
+        std::remove_cvref_t<T> &Insert(T &&object)
+        {
+            return Emplace<std::remove_cvref_t<T>>(EM_FWD(object));
+        }
+
+        // The total number of objects.
+        [[nodiscard]] std::size_t size() const
+        {
+            return [&]<std::size_t ...I>(std::index_sequence<I...>){return (segments.template get<I>().size() + ... + 0);}(std::index_sequence_for<D...>{});
+        }
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        void Reserve(std::size_t n_per_type)
+        {
+            ConstForEach<LoopSimple>(types{}, [&]<typename T>{Segment<T>().reserve(n_per_type);});
+        }
+
+        void Clear()
+        {
+            ConstForEach<LoopSimple>(types{}, [&]<typename T>{Segment<T>().clear();});
+        }
+
+        // Calls `func(T &)` for each object, segment by segment, using the specified loop backend.
+        // E.g. with `LoopAnyOf<>`, this stops at the first object for which `func` returns TRUTHY.
+        template <LoopBackendType LoopBackend = LoopSimple, typename Self>
+        decltype(auto) ForEach(this Self &self, auto &&func)
+        {
+            return ConstForEach<LoopBackend>(types{}, [&]<typename T>() -> decltype(auto)
+            {
+                auto &segment = self.template Segment<T>();
+                return Meta::ForEach<LoopBackend>(segment.begin(), segment.end(), func);
+            });
+        }
+    };
+}
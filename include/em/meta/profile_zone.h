@@ -0,0 +1,122 @@
+#pragma once
+
+#include "em/meta/const_string.h"
+#include "em/zstring_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define EM_PROFILE_ZONES_USE_TSC 1
+#else
+#include <chrono>
+#define EM_PROFILE_ZONES_USE_TSC 0
+#endif
+
+// Named scoped timers: `Meta::ProfileZone<"draw"_c> zone;` measures the time until the end of the scope.
+// Each zone gets its own slot at static initialization, so at runtime there is no hashing and no lookup, only two counter increments in thread-local memory.
+// Each thread must call `FlushProfileZones()` to publish its counters (e.g. once per frame), then `GetProfileZoneStats()` or `DumpProfileZones()` reads the totals.
+
+// Set this to 0 to compile out all zones. Then `ProfileZone` becomes an empty class, and the flushing functions do nothing.
+#ifndef EM_PROFILE_ZONES
+#define EM_PROFILE_ZONES 1
+#endif
+
+// The max number of distinct zones. The extra zones are not recorded.
+// Each thread that uses zones needs `16 * EM_PROFILE_ZONES_MAX` bytes of thread-local storage.
+#ifndef EM_PROFILE_ZONES_MAX
+#define EM_PROFILE_ZONES_MAX 256
+#endif
+
+namespace em::Meta
+{
+    // Returns the current time in the units used by the zones.
+    // This is the CPU timestamp counter on x86 (roughly cycles), or nanoseconds elsewhere.
+    [[nodiscard]] inline std::uint64_t ProfileTicks()
+    {
+        #if EM_PROFILE_ZONES_USE_TSC
+        return __rdtsc();
+        #else
+        return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        #endif
+    }
+
+    struct ProfileZoneStats
+    {
+        zstring_view name;
+        // How many times the zone was exited.
+        std::uint64_t count = 0;
+        // The total time spent in the zone, see `ProfileTicks()`.
+        std::uint64_t ticks = 0;
+    };
+
+    // Adds the counters of the current thread to the totals, and resets them.
+    // After the first call, this is also called automatically when the thread exits.
+    void FlushProfileZones();
+
+    // Returns the totals for all zones, in the order of registration. This doesn't include the data that wasn't flushed yet.
+    [[nodiscard]] std::vector<ProfileZoneStats> GetProfileZoneStats();
+
+    // Zeroes the totals. This doesn't affect the counters that weren't flushed yet.
+    void ResetProfileZoneStats();
+
+    // Returns a human-readable table of the totals, sorted by the total time.
+    [[nodiscard]] std::string DumpProfileZones();
+
+    namespace detail::ProfileZones
+    {
+        struct Counters
+        {
+            std::uint64_t count = 0;
+            std::uint64_t ticks = 0;
+        };
+
+        // Slot 0 is shared by the zones that didn't fit into `EM_PROFILE_ZONES_MAX`, and it's never reported.
+        // This is `constinit` and trivially destructible, so accessing it from other translation units doesn't go through a thread-local initialization wrapper.
+        extern constinit thread_local Counters this_thread_counters[EM_PROFILE_ZONES_MAX + 1];
+        static_assert(std::is_trivially_destructible_v<Counters>);
+
+        // Returns the slot for a new zone, or 0 if out of slots.
+        [[nodiscard]] std::size_t RegisterZone(zstring_view name);
+
+        template <ConstString Name>
+        struct Zone
+        {
+            // This is 0 until the static initialization, so the zones used before that are silently not recorded.
+            static inline const std::size_t index = RegisterZone(Name.view());
+        };
+    }
+
+    // A scoped timer, with the zone name passed as `"..."_c`.
+    template <auto Name> requires const_string_tag<std::remove_cvref_t<decltype(Name)>>
+    class ProfileZone
+    {
+        #if EM_PROFILE_ZONES
+        std::uint64_t start = ProfileTicks();
+        #endif
+
+      public:
+        static constexpr zstring_view name = decltype(Name)::value.view();
+
+        ProfileZone() = default;
+        ProfileZone(const ProfileZone &) = delete;
+        ProfileZone &operator=(const ProfileZone &) = delete;
+
+        ~ProfileZone()
+        {
+            #if EM_PROFILE_ZONES
+            detail::ProfileZones::Counters &counters = detail::ProfileZones::this_thread_counters[detail::ProfileZones::Zone<decltype(Name)::value>::index];
+            counters.count++;
+            counters.ticks += ProfileTicks() - start;
+            #endif
+        }
+    };
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 namespace em::Meta
 {
     namespace detail
@@ -24,15 +28,92 @@ namespace em::Meta
         template <template <typename, typename> typename T, typename P0, typename P1, typename ...P>
         requires requires{typename T<P0, typename ReduceIndirect<T, P1, P...>::type>::type;}
         struct ReduceIndirect<T, P0, P1, P...> {using type = typename T<P0, typename ReduceIndirect<T, P1, P...>::type>::type;};
+
+
+        // Tree reduction: split the list in two halves, reduce each, then combine them. The recursion depth is logarithmic.
+        // `Indirect` is a bool, to avoid duplicating the whole thing for `::type`.
+
+        template <bool Indirect, template <typename, typename> typename T, typename A, typename B>
+        struct ReduceTreeApply {};
+        template <template <typename, typename> typename T, typename A, typename B> requires requires{typename T<A, B>;}
+        struct ReduceTreeApply<false, T, A, B> {using type = T<A, B>;};
+        template <template <typename, typename> typename T, typename A, typename B> requires requires{typename T<A, B>::type;}
+        struct ReduceTreeApply<true, T, A, B> {using type = typename T<A, B>::type;};
+
+        template <bool Indirect, template <typename, typename> typename T, typename ...P>
+        struct ReduceTree {};
+
+        template <bool Indirect, template <typename, typename> typename T, typename I, typename J, typename ...P>
+        struct ReduceTreeHalves {};
+
+        template <bool Indirect, template <typename, typename> typename T, std::size_t ...I, std::size_t ...J, typename ...P>
+        requires requires{typename ReduceTreeApply<Indirect, T, typename ReduceTree<Indirect, T, P...[I]...>::type, typename ReduceTree<Indirect, T, P...[sizeof...(I) + J]...>::type>::type;}
+        struct ReduceTreeHalves<Indirect, T, std::index_sequence<I...>, std::index_sequence<J...>, P...>
+        {
+            using type = typename ReduceTreeApply<Indirect, T, typename ReduceTree<Indirect, T, P...[I]...>::type, typename ReduceTree<Indirect, T, P...[sizeof...(I) + J]...>::type>::type;
+        };
+
+        template <bool Indirect, template <typename, typename> typename T, typename P0>
+        struct ReduceTree<Indirect, T, P0> {using type = P0;};
+
+        template <bool Indirect, template <typename, typename> typename T, typename P0, typename P1, typename ...P>
+        requires requires{typename ReduceTreeHalves<Indirect, T, std::make_index_sequence<(sizeof...(P) + 2) / 2>, std::make_index_sequence<(sizeof...(P) + 3) / 2>, P0, P1, P...>::type;}
+        struct ReduceTree<Indirect, T, P0, P1, P...>
+        {
+            using type = typename ReduceTreeHalves<Indirect, T, std::make_index_sequence<(sizeof...(P) + 2) / 2>, std::make_index_sequence<(sizeof...(P) + 3) / 2>, P0, P1, P...>::type;
+        };
+
+
+        // Left fold: a fold expression over an operator overloaded on these accumulators. This doesn't recurse at all.
+
+        template <bool Indirect, template <typename, typename> typename T, typename A>
+        struct ReduceLeftAcc
+        {
+            using type = A;
+
+            // Only used in `decltype`, so not defined.
+            template <typename B>
+            friend auto operator+(ReduceLeftAcc, std::type_identity<B>) -> ReduceLeftAcc<Indirect, T, typename ReduceTreeApply<Indirect, T, A, B>::type>;
+        };
+
+        template <bool Indirect, template <typename, typename> typename T, typename P0, typename ...P>
+        struct ReduceLeft {};
+
+        template <bool Indirect, template <typename, typename> typename T, typename P0, typename ...P>
+        requires requires{(ReduceLeftAcc<Indirect, T, P0>{} + ... + std::type_identity<P>{});}
+        struct ReduceLeft<Indirect, T, P0, P...> {using type = typename decltype((ReduceLeftAcc<Indirect, T, P0>{} + ... + std::type_identity<P>{}))::type;};
     }
 
     // Reduces list `P...` over `T<A,B>`. If there's only one `P`, returns it unchanged. If `P...` is empty, fails.
+    // This is a right fold: `T<P0, T<P1, T<P2, P3>>>`. It recurses once per element, prefer `reduce_types_tree` or `reduce_types_left` for long lists.
     template <template <typename, typename> typename T, typename ...P>
     requires requires{typename detail::Reduce<T, P...>::type;}
     using reduce_types = detail::Reduce<T, P...>::type;
 
     // Reduces list `P...` over `T<A,B>::type`. If there's only one `P`, returns it unchanged. If `P...` is empty, fails.
+    // This is a right fold, see `reduce_types`.
     template <template <typename, typename> typename T, typename ...P>
     requires requires{typename detail::ReduceIndirect<T, P...>::type;}
     using reduce_types_indirect = detail::ReduceIndirect<T, P...>::type;
+
+    // Same as `reduce_types`, but reduces pairwise: `T<T<P0, P1>, T<P2, P3>>`. The instantiation depth is O(log N).
+    // The result only matches the other variants if `T` is associative.
+    template <template <typename, typename> typename T, typename ...P>
+    requires requires{typename detail::ReduceTree<false, T, P...>::type;}
+    using reduce_types_tree = detail::ReduceTree<false, T, P...>::type;
+
+    // Same as `reduce_types_indirect`, but reduces pairwise, see `reduce_types_tree`.
+    template <template <typename, typename> typename T, typename ...P>
+    requires requires{typename detail::ReduceTree<true, T, P...>::type;}
+    using reduce_types_tree_indirect = detail::ReduceTree<true, T, P...>::type;
+
+    // Same as `reduce_types`, but folds left: `T<T<T<P0, P1>, P2>, P3>`. This uses a fold expression instead of recursive instantiations.
+    template <template <typename, typename> typename T, typename ...P>
+    requires requires{typename detail::ReduceLeft<false, T, P...>::type;}
+    using reduce_types_left = detail::ReduceLeft<false, T, P...>::type;
+
+    // Same as `reduce_types_indirect`, but folds left, see `reduce_types_left`.
+    template <template <typename, typename> typename T, typename ...P>
+    requires requires{typename detail::ReduceLeft<true, T, P...>::type;}
+    using reduce_types_left_indirect = detail::ReduceLeft<true, T, P...>::type;
 }
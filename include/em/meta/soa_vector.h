@@ -0,0 +1,321 @@
+#pragma once
+
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/const_for.h"
+#include "em/meta/lists.h"
+#include "em/meta/tuple.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// A struct-of-arrays container: one contiguous array per field, all in a single allocation.
+
+namespace em::Meta
+{
+    template <typename ...F>
+    class SoAVector;
+
+    // A reference to a single element ("row") of a `SoAVector`. `get<I>()` returns the `I`th field of it.
+    // Supports structured bindings, which then bind to the fields by reference.
+    template <bool Const, typename ...F>
+    class SoAVectorRow
+    {
+        maybe_const<Const, SoAVector<F...>> *vec = nullptr;
+        std::size_t i = 0;
+
+      public:
+        constexpr SoAVectorRow() {}
+        constexpr SoAVectorRow(maybe_const<Const, SoAVector<F...>> &vec, std::size_t i) : vec(&vec), i(i) {}
+
+        // A mutable row converts to a const one.
+        constexpr operator SoAVectorRow<true, F...>() const requires (!Const) {return SoAVectorRow<true, F...>(*vec, i);}
+
+        [[nodiscard]] constexpr std::size_t index() const {return i;}
+
+        template <std::size_t I> requires (I < sizeof...(F))
+        [[nodiscard]] maybe_const<Const, F...[I]> &get() const {return vec->template Field<I>()[i];}
+    };
+
+    // One contiguous array per field type `F...` (or per element of a `TypeList<F...>`), all sharing a single allocation.
+    // Each array is aligned to `array_alignment` (at least a cache line), which is convenient for SIMD loops over `Field<I>()`.
+    // The fields must be nothrow move-constructible and move-assignable, since they are relocated on reallocation and shifted on erasure.
+    template <typename ...F>
+    class SoAVector
+    {
+        static_assert(sizeof...(F) > 0, "Need at least one field.");
+        static_assert((std::is_nothrow_move_constructible_v<F> && ...), "The fields must be nothrow move-constructible.");
+        static_assert((std::is_nothrow_move_assignable_v<F> && ...), "The fields must be nothrow move-assignable, since erasing shifts them.");
+        static_assert(((std::is_object_v<F> && !std::is_array_v<F> && cv_unqualified<F>) && ...), "The fields must be cv-unqualified non-array object types.");
+
+      public:
+        using types = TypeList<F...>;
+        using row = SoAVectorRow<false, F...>;
+        using const_row = SoAVectorRow<true, F...>;
+
+        static constexpr std::size_t num_fields = sizeof...(F);
+        static constexpr std::size_t array_alignment = std::max({std::size_t(64), alignof(F)...});
+
+      private:
+        std::byte *block = nullptr;
+        Tuple<F *...> arrays;
+        std::size_t num_elems = 0;
+        std::size_t cap = 0;
+
+        // Returns the offsets of the arrays in a block with capacity `n`. The last element is the block size.
+        [[nodiscard]] static constexpr std::array<std::size_t, num_fields + 1> Offsets(std::size_t n)
+        {
+            constexpr std::size_t sizes[] = {sizeof(F)...};
+            std::array<std::size_t, num_fields + 1> ret{};
+            for (std::size_t i = 0; i < num_fields; i++)
+                ret[i + 1] = (ret[i] + sizes[i] * n + array_alignment - 1) / array_alignment * array_alignment;
+            return ret;
+        }
+
+        // Allocates an uninitialized block with capacity `n`, and sets `new_arrays` to point into it.
+        [[nodiscard]] static std::byte *Allocate(std::size_t n, Tuple<F *...> &new_arrays)
+        {
+            if (n == 0)
+            {
+                new_arrays = {};
+                return nullptr;
+            }
+
+            const std::array<std::size_t, num_fields + 1> offsets = Offsets(n);
+            std::byte *new_block = static_cast<std::byte *>(::operator new(offsets.back(), std::align_val_t(array_alignment)));
+            ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                new_arrays.template get<I>() = reinterpret_cast<F...[I] *>(new_block + offsets[I]);
+            });
+            return new_block;
+        }
+
+        static void Deallocate(std::byte *target) noexcept
+        {
+            if (target)
+                ::operator delete(target, std::align_val_t(array_alignment));
+        }
+
+        // Moves the elements to `new_block` with capacity `new_cap` (at least `num_elems`), and frees the old block.
+        void Adopt(std::byte *new_block, const Tuple<F *...> &new_arrays, std::size_t new_cap) noexcept
+        {
+            ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                std::uninitialized_move_n(arrays.template get<I>(), num_elems, new_arrays.template get<I>());
+                std::destroy_n(arrays.template get<I>(), num_elems);
+            });
+
+            Deallocate(block);
+            block = new_block;
+            arrays = new_arrays;
+            cap = new_cap;
+        }
+
+        void Reallocate(std::size_t new_cap)
+        {
+            Tuple<F *...> new_arrays;
+            std::byte *new_block = Allocate(new_cap, new_arrays);
+            Adopt(new_block, new_arrays, new_cap);
+        }
+
+        // Constructs `count` elements in `target_arrays`, starting at index `num_elems`. See `AppendWith()` for `init`.
+        template <typename G>
+        void ConstructNew(const Tuple<F *...> &target_arrays, std::size_t count, G &init)
+        {
+            std::size_t done = 0;
+            try
+            {
+                ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                    init.template operator()<I>(target_arrays.template get<I>() + num_elems);
+                    done++;
+                });
+            }
+            catch (...)
+            {
+                ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                    if (I < done)
+                        std::destroy_n(target_arrays.template get<I>() + num_elems, count);
+                });
+                throw;
+            }
+        }
+
+        // Adds `count` elements at the end. `init.template operator()<I>(ptr)` must construct them in the `I`th array starting at `ptr`,
+        //   and must clean up after itself if it throws (like the `std::uninitialized_...` functions do).
+        // When growing, the new elements are constructed in the new block before the old ones are moved out,
+        //   so `init` can read the existing elements (e.g. `PushBack(v[0].get<0>(), ...)` works, like with `std::vector`).
+        template <typename G>
+        void AppendWith(std::size_t count, G &&init)
+        {
+            if (cap - num_elems >= count)
+            {
+                ConstructNew(arrays, count, init);
+            }
+            else
+            {
+                const std::size_t new_cap = std::max(num_elems + count, cap * 2);
+                Tuple<F *...> new_arrays;
+                std::byte *new_block = Allocate(new_cap, new_arrays);
+                try
+                {
+                    ConstructNew(new_arrays, count, init);
+                }
+                catch (...)
+                {
+                    Deallocate(new_block);
+                    throw;
+                }
+                Adopt(new_block, new_arrays, new_cap);
+            }
+
+            num_elems += count;
+        }
+
+      public:
+        constexpr SoAVector() {}
+
+        SoAVector(const SoAVector &other) requires (std::is_copy_constructible_v<F> && ...)
+        {
+            // `AppendWith()` allocates exactly `other.num_elems`, and frees the block if copying throws.
+            AppendWith(other.num_elems, [&]<std::size_t I>(auto *dest){std::uninitialized_copy_n(other.arrays.template get<I>(), other.num_elems, dest);});
+        }
+
+        // Like `ZeroMovedFrom`, this leaves `other` empty.
+        SoAVector(SoAVector &&other) noexcept
+            : block(std::exchange(other.block, nullptr)), arrays(std::exchange(other.arrays, {})), num_elems(std::exchange(other.num_elems, 0)), cap(std::exchange(other.cap, 0))
+        {}
+
+        SoAVector &operator=(SoAVector other) noexcept
+        {
+            Swap(other);
+            return *this;
+        }
+
+        ~SoAVector()
+        {
+            Clear();
+            Deallocate(block);
+        }
+
+        void Swap(SoAVector &other) noexcept
+        {
+            std::swap(block, other.block);
+            std::swap(arrays, other.arrays);
+            std::swap(num_elems, other.num_elems);
+            std::swap(cap, other.cap);
+        }
+
+        [[nodiscard]] std::size_t size() const {return num_elems;}
+        [[nodiscard]] bool empty() const {return num_elems == 0;}
+        [[nodiscard]] std::size_t capacity() const {return cap;}
+
+        // Returns the `I`th field of all elements.
+        template <std::size_t I> requires (I < num_fields)
+        [[nodiscard]] std::span<F...[I]> Field() {return {arrays.template get<I>(), num_elems};}
+        template <std::size_t I> requires (I < num_fields)
+        [[nodiscard]] std::span<const F...[I]> Field() const {return {arrays.template get<I>(), num_elems};}
+
+        // Returns a reference to the `i`th element.
+        [[nodiscard]] row operator[](std::size_t i) {return row(*this, i);}
+        [[nodiscard]] const_row operator[](std::size_t i) const {return const_row(*this, i);}
+
+        // Calls `func(Field<I>())` for each field, using the specified loop backend.
+        template <LoopBackendType LoopBackend = LoopSimple, typename Self>
+        decltype(auto) ForEachField(this Self &self, auto &&func)
+        {
+            return ConstFor<LoopBackend, num_fields>([&]<std::size_t I>() -> decltype(auto) {return func(self.template Field<I>());});
+        }
+
+        void Reserve(std::size_t n)
+        {
+            if (n > cap)
+                Reallocate(n);
+        }
+
+        void ShrinkToFit()
+        {
+            if (cap > num_elems)
+                Reallocate(num_elems);
+        }
+
+        // Adds an element, constructing each field from the respective argument.
+        template <typename ...A> requires (sizeof...(A) == num_fields) && (std::is_constructible_v<F, A &&> && ...)
+        row PushBack(A &&... fields)
+        {
+            AppendWith(1, [&]<std::size_t I>(auto *dest){std::construct_at(dest, EM_FWD(fields...[I]));});
+            return row(*this, num_elems - 1);
+        }
+
+        // Adds `count` copies of the same element.
+        void Append(std::size_t count, const F &... fields) requires (std::is_copy_constructible_v<F> && ...)
+        {
+            AppendWith(count, [&]<std::size_t I>(auto *dest){std::uninitialized_fill_n(dest, count, fields...[I]);});
+        }
+
+        // Adds or removes elements at the end. New elements are value-initialized.
+        void Resize(std::size_t n) requires (std::is_default_constructible_v<F> && ...)
+        {
+            if (n < num_elems)
+                Erase(n, num_elems);
+            else
+                AppendWith(n - num_elems, [&]<std::size_t I>(auto *dest){std::uninitialized_value_construct_n(dest, n - num_elems);});
+        }
+
+        // Removes the elements in range `[begin, end)`, shifting the following ones.
+        void Erase(std::size_t begin, std::size_t end) noexcept
+        {
+            if (begin == end)
+                return;
+            ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                auto *array = arrays.template get<I>();
+                std::move(array + end, array + num_elems, array + begin);
+                std::destroy(array + num_elems - (end - begin), array + num_elems);
+            });
+            num_elems -= end - begin;
+        }
+        void Erase(std::size_t i) noexcept
+        {
+            Erase(i, i + 1);
+        }
+
+        // Removes the `i`th element by moving the last one into its place. This doesn't preserve the order, but is O(1).
+        void EraseUnordered(std::size_t i) noexcept
+        {
+            ConstFor<LoopSimple, num_fields>([&]<std::size_t I>{
+                auto *array = arrays.template get<I>();
+                if (i != num_elems - 1)
+                    array[i] = std::move(array[num_elems - 1]);
+                std::destroy_at(array + num_elems - 1);
+            });
+            num_elems--;
+        }
+
+        void PopBack() noexcept
+        {
+            Erase(num_elems - 1, num_elems);
+        }
+
+        // Destroys all elements, but keeps the capacity.
+        void Clear() noexcept
+        {
+            Erase(0, num_elems);
+        }
+    };
+
+    template <typename ...F>
+    class SoAVector<TypeList<F...>> : public SoAVector<F...>
+    {
+        using SoAVector<F...>::SoAVector;
+    };
+}
+
+template <bool Const, typename ...F>
+struct std::tuple_size<em::Meta::SoAVectorRow<Const, F...>> : std::integral_constant<std::size_t, sizeof...(F)> {};
+
+template <std::size_t I, bool Const, typename ...F>
+struct std::tuple_element<I, em::Meta::SoAVectorRow<Const, F...>> {using type = em::Meta::maybe_const<Const, F...[I]> &;};
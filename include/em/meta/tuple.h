@@ -0,0 +1,147 @@
+#pragma once
+
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/lists.h"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// A tuple with flat (non-recursive) storage, where the elements are physically sorted by alignment to minimize padding.
+
+namespace em::Meta
+{
+    namespace detail::Tuple
+    {
+        // The alignment that `T` has when stored as a member. References are stored as pointers.
+        template <typename T>
+        constexpr std::size_t member_alignment = alignof(std::conditional_t<std::is_reference_v<T>, void *, T>);
+
+        // `physical_order<P...>[k]` is the logical index of the `k`th element in memory.
+        // This is a stable sort by decreasing alignment, which leaves no padding between the elements (since sizes are multiples of alignments).
+        template <typename ...P>
+        constexpr std::array<std::size_t, sizeof...(P)> physical_order = []{
+            constexpr std::size_t alignments[] = {member_alignment<P>..., 0}; // The extra element is for empty packs.
+            std::array<std::size_t, sizeof...(P)> ret{};
+            for (std::size_t i = 0; i < sizeof...(P); i++)
+            {
+                // Insertion sort.
+                std::size_t j = i;
+                while (j > 0 && alignments[ret[j - 1]] < alignments[i])
+                {
+                    ret[j] = ret[j - 1];
+                    j--;
+                }
+                ret[j] = i;
+            }
+            return ret;
+        }();
+
+        // The inverse of `physical_order`: `physical_index<P...>[i]` is the position in memory of the `i`th logical element.
+        template <typename ...P>
+        constexpr std::array<std::size_t, sizeof...(P)> physical_index = []{
+            std::array<std::size_t, sizeof...(P)> ret{};
+            for (std::size_t k = 0; k < sizeof...(P); k++)
+                ret[physical_order<P...>[k]] = k;
+            return ret;
+        }();
+
+        // Stores a single element. `K` is the physical index, it's only needed to make the bases distinct.
+        template <std::size_t K, typename T>
+        struct Leaf
+        {
+            [[no_unique_address]] T value;
+
+            constexpr Leaf() requires std::is_default_constructible_v<T> : value() {}
+
+            // Direct-initializes the element, to match the `std::is_constructible_v` check in `Tuple`'s constructor.
+            template <typename A>
+            constexpr Leaf(std::in_place_t, A &&arg) : value(EM_FWD(arg)) {}
+
+            friend constexpr bool operator==(const Leaf &, const Leaf &) = default;
+        };
+
+        template <typename K, typename ...P>
+        struct Storage {};
+
+        // The bases are listed in the physical order, since that's the order in which they're laid out.
+        template <std::size_t ...K, typename ...P>
+        struct Storage<std::index_sequence<K...>, P...> : Leaf<K, P...[physical_order<P...>[K]]>...
+        {
+            // Value-initializes the elements, like `std::tuple`.
+            constexpr Storage() requires (std::is_default_constructible_v<P> && ...)
+                : Leaf<K, P...[physical_order<P...>[K]]>()...
+            {}
+
+            // The arguments are in the logical order.
+            template <typename ...A>
+            constexpr Storage(std::in_place_t, A &&... args)
+                : Leaf<K, P...[physical_order<P...>[K]]>(std::in_place, EM_FWD(args...[physical_order<P...>[K]]))...
+            {}
+
+            friend constexpr bool operator==(const Storage &, const Storage &) = default;
+        };
+    }
+
+    // A tuple with flat storage, where the elements are physically ordered by decreasing alignment, which minimizes padding.
+    // `get<I>()` still uses the logical order, the order in memory is an implementation detail.
+    // `Tuple<TypeList<P...>>` is the same as `Tuple<P...>`, and `list_apply_types<Tuple, L>` works too.
+    template <typename ...P>
+    class Tuple : public detail::Tuple::Storage<std::index_sequence_for<P...>, P...>
+    {
+        using storage = detail::Tuple::Storage<std::index_sequence_for<P...>, P...>;
+
+      public:
+        using types = TypeList<P...>;
+        static constexpr std::size_t size = sizeof...(P);
+        template <std::size_t I>
+        using type_at = P...[I];
+
+        constexpr Tuple() requires (std::is_default_constructible_v<P> && ...) = default;
+
+        // Constructs each element from the respective argument. This is explicit if any of the conversions are, like in `std::tuple`.
+        template <typename ...A>
+        requires
+            (sizeof...(A) == sizeof...(P)) && (sizeof...(P) > 0) &&
+            (sizeof...(P) != 1 || !same_or_derived_from_ignoring_cvref<first_type<A...>, Tuple>) && // Don't conflict with the copy and move constructors.
+            (std::is_constructible_v<P, A &&> && ...)
+        constexpr explicit(!(std::is_convertible_v<A &&, P> && ...)) Tuple(A &&... args)
+            : storage(std::in_place, EM_FWD(args)...)
+        {}
+
+        // Returns the `I`th element, with the cvref-qualifiers of the tuple applied to it, like `std::get()`.
+        template <std::size_t I, typename Self> requires (I < sizeof...(P))
+        [[nodiscard]] constexpr copy_cvref<Self &&, P...[I]> get(this Self &&self) noexcept
+        {
+            using leaf = detail::Tuple::Leaf<detail::Tuple::physical_index<P...>[I], P...[I]>;
+            return static_cast<copy_cvref<Self &&, P...[I]>>(static_cast<copy_cv<Self, leaf> &>(self).value);
+        }
+
+        friend constexpr bool operator==(const Tuple &, const Tuple &) = default;
+    };
+
+    template <typename ...P>
+    class Tuple<TypeList<P...>> : public Tuple<P...>
+    {
+        using Tuple<P...>::Tuple;
+    };
+
+    template <typename ...P>
+    Tuple(P...) -> Tuple<P...>;
+
+    // Same as `tuple.get<I>()`.
+    template <std::size_t I, typename T> requires requires(T &&tuple){EM_FWD(tuple).template get<I>();}
+    [[nodiscard]] constexpr decltype(auto) get(T &&tuple) noexcept
+    {
+        return EM_FWD(tuple).template get<I>();
+    }
+}
+
+template <typename ...P>
+struct std::tuple_size<em::Meta::Tuple<P...>> : std::integral_constant<std::size_t, em::Meta::Tuple<P...>::size> {};
+
+template <std::size_t I, typename ...P>
+struct std::tuple_element<I, em::Meta::Tuple<P...>> {using type = typename em::Meta::Tuple<P...>::template type_at<I>;};
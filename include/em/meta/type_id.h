@@ -0,0 +1,77 @@
+#pragma once
+
+#include "em/meta/hash.h"
+
+#include <cstdint>
+#include <string_view>
+#include <typeinfo>
+
+// A replacement for `std::type_info` that's usable in constant expressions.
+// The identity is the address of a per-type inline variable, so comparisons never degrade to comparing mangled names.
+// Like with any inline variable, this breaks if the same type is used from several shared libraries that don't export their symbols.
+//   If that's a concern, compare `.hash()` instead, or convert to `std::type_info`.
+
+namespace em::Meta
+{
+    namespace detail::TypeIds
+    {
+        // Returns a string that uniquely identifies `T`. The exact spelling is compiler-specific.
+        template <typename T>
+        [[nodiscard]] constexpr std::string_view RawName()
+        {
+            #ifdef _MSC_VER
+            return __FUNCSIG__;
+            #else
+            return __PRETTY_FUNCTION__;
+            #endif
+        }
+
+        template <typename T>
+        [[nodiscard]] const std::type_info &GetTypeInfo()
+        {
+            return typeid(T);
+        }
+
+        struct Data
+        {
+            std::uint64_t hash = 0;
+            const std::type_info &(*get_type_info)() = nullptr;
+        };
+
+        template <typename T>
+        inline constexpr Data data = {.hash = HashString(RawName<T>()), .get_type_info = GetTypeInfo<T>};
+    }
+
+    // A constexpr hash of a type.
+    // It's stable between runs, but not between different compilers or different versions of this library.
+    template <typename T>
+    constexpr std::uint64_t type_hash = detail::TypeIds::data<T>.hash;
+
+    // Identifies a type. Unlike `std::type_info`, this respects cv-qualifiers and references.
+    class TypeId
+    {
+        const detail::TypeIds::Data *data = nullptr;
+
+      public:
+        // A null ID, that compares different from all types.
+        constexpr TypeId() {}
+
+        // Don't use directly, use `type_id<T>` instead.
+        constexpr explicit TypeId(const detail::TypeIds::Data &data) : data(&data) {}
+
+        [[nodiscard]] constexpr explicit operator bool() const {return bool(data);}
+
+        // This is just a pointer comparison, and works in constant expressions.
+        [[nodiscard]] friend constexpr bool operator==(TypeId, TypeId) = default;
+
+        // Returns `type_hash` of this type, or 0 if this is a null ID.
+        [[nodiscard]] constexpr std::uint64_t hash() const {return data ? data->hash : 0;}
+
+        // Converts to `std::type_info`. Note that it ignores cvref-qualifiers. Must not be null.
+        [[nodiscard]] const std::type_info &type_info() const {return data->get_type_info();}
+    };
+
+    // Returns the ID of `T`, respecting the cvref-qualifiers.
+    template <typename T>
+    constexpr TypeId type_id = TypeId(detail::TypeIds::data<T>);
+}
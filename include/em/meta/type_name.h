@@ -9,28 +9,178 @@
 #define EM_CONSTEXPR_TYPE_NAME 0
 #endif
 
+#include "em/meta/lists.h"
 #include "em/zstring_view.h"
 
 #if EM_CONSTEXPR_TYPE_NAME
 #include <cppdecl/type_name.h>
 #endif
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <typeinfo> // IWYU pragma: keep. We do use `typeid()` below, silence the false positive.
 
 namespace em::Meta
 {
+    // Demangles and normalizes the type name. This allocates and re-parses the name on every call, prefer `TypeNameDynamicInterned()` on hot paths.
     [[nodiscard]] std::string TypeNameDynamic(std::type_index type);
 
+    // Same as `TypeNameDynamic()`, but caches the result. The returned string lives until the end of the program.
+    // This is thread-safe. Only the first call for each type allocates, the following ones only take a shared lock.
+    [[nodiscard]] zstring_view TypeNameDynamicInterned(std::type_index type);
+
+    // Calls `TypeNameDynamicInterned()` for each of the types, to avoid paying for the first call later.
+    // This is optional and only helps with latency, `TypeNameDynamicInterned()` works fine without it.
+    void PrewarmTypeNames(std::span<const std::type_index> types);
+
     template <typename T>
     [[nodiscard]] zstring_view TypeName()
     {
         #if EM_CONSTEXPR_TYPE_NAME
         return zstring_view(zstring_view::TrustNullTerminated{}, cppdecl::TypeName<T>());
         #else
-        static const std::string ret = TypeNameDynamic(typeid(T));
+        static const zstring_view ret = TypeNameDynamicInterned(typeid(T));
         return ret;
         #endif
     }
+
+
+    // A list of type names, returned by `TypeNames()` below.
+    class TypeNameTable
+    {
+        #if EM_CONSTEXPR_TYPE_NAME
+        // The names are stored in one null-terminated buffer. Each entry is `offset | length << 32`.
+        const char *buffer = nullptr;
+        const std::uint64_t *entries = nullptr;
+        #else
+        const zstring_view *names = nullptr;
+        #endif
+        std::size_t num_names = 0;
+
+      public:
+        constexpr TypeNameTable() {}
+
+        #if EM_CONSTEXPR_TYPE_NAME
+        constexpr TypeNameTable(const char *buffer, const std::uint64_t *entries, std::size_t num_names) : buffer(buffer), entries(entries), num_names(num_names) {}
+        #else
+        constexpr TypeNameTable(const zstring_view *names, std::size_t num_names) : names(names), num_names(num_names) {}
+        #endif
+
+        [[nodiscard]] constexpr std::size_t size() const {return num_names;}
+
+        // Doesn't check the index.
+        [[nodiscard]] constexpr zstring_view operator[](std::size_t i) const
+        {
+            #if EM_CONSTEXPR_TYPE_NAME
+            return zstring_view(zstring_view::TrustNullTerminated{}, std::string_view(buffer + std::uint32_t(entries[i]), std::size_t(entries[i] >> 32)));
+            #else
+            return names[i];
+            #endif
+        }
+    };
+
+    namespace detail::TypeNames
+    {
+        template <typename L>
+        struct Table {};
+
+        #if EM_CONSTEXPR_TYPE_NAME
+        template <std::size_t N>
+        struct Layout
+        {
+            std::size_t buffer_size = 0;
+            std::array<std::uint64_t, N> entries{};
+        };
+
+        // Decides where each name goes in the buffer.
+        // If a name is a suffix of a name that's already in the buffer (including a duplicate of it), we reuse its null-terminator instead of adding a copy.
+        // Common prefixes (namespaces) can't be shared this way, but those aren't cheap to deduplicate anyway.
+        template <std::size_t N>
+        [[nodiscard]] consteval Layout<N> ComputeLayout(const std::array<std::string_view, N> &names)
+        {
+            // Place longer names first, to give the shorter ones a chance to be stored as their suffixes.
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; i++)
+            {
+                std::size_t j = i;
+                while (j > 0 && names[order[j - 1]].size() < names[i].size())
+                {
+                    order[j] = order[j - 1];
+                    j--;
+                }
+                order[j] = i;
+            }
+
+            Layout<N> ret;
+            for (std::size_t i = 0; i < N; i++)
+            {
+                std::string_view name = names[order[i]];
+                std::size_t offset = ret.buffer_size;
+
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    std::string_view prev = names[order[j]];
+                    if (prev.ends_with(name))
+                    {
+                        offset = std::uint32_t(ret.entries[order[j]]) + prev.size() - name.size();
+                        break;
+                    }
+                }
+
+                if (offset == ret.buffer_size)
+                    ret.buffer_size += name.size() + 1;
+
+                ret.entries[order[i]] = std::uint64_t(offset) | std::uint64_t(name.size()) << 32;
+            }
+
+            return ret;
+        }
+
+        template <typename ...P>
+        struct Table<TypeList<P...>>
+        {
+            static constexpr std::array<std::string_view, sizeof...(P)> names = {std::string_view(cppdecl::TypeName<P>())...};
+            static constexpr Layout<sizeof...(P)> layout = ComputeLayout(names);
+
+            static constexpr std::array<char, layout.buffer_size> buffer = []{
+                std::array<char, layout.buffer_size> ret{}; // Already null-terminated everywhere.
+                for (std::size_t i = 0; i < sizeof...(P); i++)
+                {
+                    std::size_t offset = std::uint32_t(layout.entries[i]);
+                    for (std::size_t j = 0; j < names[i].size(); j++)
+                        ret[offset + j] = names[i][j];
+                }
+                return ret;
+            }();
+
+            static constexpr TypeNameTable value = TypeNameTable(buffer.data(), layout.entries.data(), sizeof...(P));
+        };
+        #endif
+    }
+
+    // Returns the names of all types in the `TypeList<...>`, indexable in O(1).
+    // In release builds all names live in one contiguous constexpr buffer (sharing storage when one name is a suffix of another),
+    //   otherwise they are computed on the first call and interned.
+    template <typename L>
+    [[nodiscard]]
+    #if EM_CONSTEXPR_TYPE_NAME
+    constexpr
+    #endif
+    TypeNameTable TypeNames()
+    {
+        #if EM_CONSTEXPR_TYPE_NAME
+        return detail::TypeNames::Table<L>::value;
+        #else
+        return []<typename ...P>(TypeList<P...>)
+        {
+            static const std::array<zstring_view, sizeof...(P)> names = {TypeName<P>()...};
+            return TypeNameTable(names.data(), sizeof...(P));
+        }(L{});
+        #endif
+    }
 }
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "em/macros/portable/tiny_func.h"
+#include "em/macros/utils/forward.h"
+#include "em/meta/common.h"
+#include "em/meta/const_for.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// A replacement for `std::visit()` with a predictable dispatch strategy.
+// Usually used with `Meta::Overload{...}` as the functor.
+
+namespace em::Meta
+{
+    namespace detail::Visit
+    {
+        // If the number of combinations of alternatives is at most this, we use a chain of `if`s instead of a function pointer table.
+        // Compilers turn those into `switch`es, and can inline the handlers, which they can't do through the table.
+        inline constexpr std::size_t max_combinations_for_branches = 8;
+
+        // `std::variant` or anything else that specializes `std::variant_size` and has `.index()` and `.valueless_by_exception()`.
+        // Those other types must have a member `.template get_unchecked<I>()` or `.template get<I>()`, while for `std::variant` we use `std::get<I>()`.
+        template <typename V>
+        concept VariantLike = requires(const V &v)
+        {
+            std::variant_size<std::remove_cvref_t<V>>::value;
+            v.index();
+            v.valueless_by_exception();
+        };
+
+        template <std::size_t I, typename V>
+        [[nodiscard]] EM_TINY constexpr decltype(auto) GetAlternative(V &&variant)
+        {
+            if constexpr (specialization_of_ignoring_cvref<V, std::variant>)
+                return std::get<I>(EM_FWD(variant));
+            else if constexpr (requires{EM_FWD(variant).template get_unchecked<I>();})
+                return EM_FWD(variant).template get_unchecked<I>(); // We've already checked the index.
+            else
+                return EM_FWD(variant).template get<I>();
+        }
+
+        // `F` and `V...` are forwarding references.
+        template <typename F, typename ...V>
+        struct Visitor
+        {
+            static constexpr std::size_t sizes[] = {std::variant_size_v<std::remove_cvref_t<V>>...};
+            static constexpr std::size_t num_combinations = (std::variant_size_v<std::remove_cvref_t<V>> * ...);
+
+            // Given a flat index of a combination of alternatives, returns the alternative index in the `k`th variant.
+            // The last variant changes the fastest.
+            [[nodiscard]] static constexpr std::size_t AltIndex(std::size_t flat, std::size_t k)
+            {
+                for (std::size_t j = sizeof...(V) - 1; j > k; j--)
+                    flat /= sizes[j];
+                return flat % sizes[k];
+            }
+
+            template <std::size_t I>
+            [[nodiscard]] EM_TINY static constexpr decltype(auto) Call(F &&func, V &&... variants)
+            {
+                return [&]<std::size_t ...K>(std::index_sequence<K...>) -> decltype(auto)
+                {
+                    return std::invoke(EM_FWD(func), (GetAlternative<AltIndex(I, K)>)(EM_FWD(variants))...);
+                }(std::make_index_sequence<sizeof...(V)>{});
+            }
+
+            template <std::size_t ...I>
+            static constexpr bool SameReturnTypes(std::index_sequence<I...>)
+            {
+                return same_as_all<decltype(Call<I>(std::declval<F>(), std::declval<V>()...))...>;
+            }
+
+            template <std::size_t I>
+            [[nodiscard]] EM_TINY static constexpr decltype(auto) CallBranches(std::size_t index, F &&func, V &&... variants)
+            {
+                // The last combination doesn't need a check, the index is always in range.
+                if constexpr (I + 1 < num_combinations)
+                {
+                    if (index != I)
+                        return (CallBranches<I + 1>)(index, EM_FWD(func), EM_FWD(variants)...);
+                }
+                return Call<I>(EM_FWD(func), EM_FWD(variants)...);
+            }
+
+            template <std::size_t ...I>
+            [[nodiscard]] static constexpr decltype(auto) CallTable(std::size_t index, F &&func, V &&... variants, std::index_sequence<I...>)
+            {
+                static constexpr decltype(&Call<0>) table[] = {&Call<I>...};
+                return table[index](EM_FWD(func), EM_FWD(variants)...);
+            }
+
+            [[nodiscard]] static constexpr decltype(auto) Run(F &&func, V &&... variants)
+            {
+                static_assert(SameReturnTypes(std::make_index_sequence<num_combinations>{}), "The functor must return the same type for all combinations of alternatives.");
+
+                if ((variants.valueless_by_exception() || ...))
+                    throw std::bad_variant_access{};
+
+                // Combine the indices.
+                std::size_t index = 0;
+                ((index = index * std::variant_size_v<std::remove_cvref_t<V>> + variants.index()), ...);
+
+                if constexpr (num_combinations <= max_combinations_for_branches)
+                    return CallBranches<0>(index, EM_FWD(func), EM_FWD(variants)...);
+                else
+                    return CallTable(index, EM_FWD(func), EM_FWD(variants)..., std::make_index_sequence<num_combinations>{});
+            }
+        };
+    }
+
+    // Like `std::visit()`. Calls `func` with the current alternatives of all `variants`.
+    // Accepts `std::variant`s and `CompactVariant`s.
+    // The combination of alternatives is flattened into a single index. For a few combinations (`detail::Visit::max_combinations_for_branches`)
+    //   we dispatch with a chain of `if`s (that compilers turn into a `switch`), otherwise with a single flat table of function pointers.
+    // All combinations must return the same type. Throws `std::bad_variant_access` if any variant is valueless.
+    template <Deduce..., typename F, typename ...V>
+    requires (sizeof...(V) > 0) && (detail::Visit::VariantLike<V> && ...)
+    constexpr decltype(auto) Visit(F &&func, V &&... variants)
+    {
+        return detail::Visit::Visitor<F &&, V &&...>::Run(EM_FWD(func), EM_FWD(variants)...);
+    }
+
+    // Visits each variant in a range, with the specified loop backend.
+    // E.g. with `LoopAnyOf<>`, this stops at the first variant for which `func` returns TRUTHY.
+    template <LoopBackendType LoopBackend, Deduce...>
+    constexpr decltype(auto) VisitEach(auto begin, auto end, auto &&func)
+    {
+        return ForEach<LoopBackend>(std::move(begin), std::move(end), [&](auto &&variant) -> decltype(auto) {return (Visit)(func, EM_FWD(variant));});
+    }
+}
@@ -0,0 +1,260 @@
+#include "em/meta/binary_log.h"
+
+#include <charconv>
+#include <mutex>
+
+namespace em::Meta
+{
+    namespace
+    {
+        std::atomic<const BinaryLogFormat *> first_format = nullptr;
+
+        struct Rings
+        {
+            std::mutex mutex;
+            detail::BinaryLog::Ring *first = nullptr;
+        };
+
+        [[nodiscard]] Rings &GetRings()
+        {
+            // Intentionally leaked, to allow logging during static destruction.
+            static Rings &ret = *new Rings;
+            return ret;
+        }
+
+        // Those are trivially destructible, so they remain usable in the destructors of other `thread_local`s.
+        constinit thread_local detail::BinaryLog::Ring *this_thread_ring = nullptr;
+        // Set when `RingOwner` is destroyed. After that the thread never creates a new buffer, since nothing would release it.
+        constinit thread_local bool this_thread_ring_released = false;
+
+        // Marks the buffer of the current thread as unused when the thread exits.
+        // After that the drainer may delete the buffer at any moment, so we forget it.
+        struct RingOwner
+        {
+            RingOwner() = default;
+            RingOwner(const RingOwner &) = delete;
+            RingOwner &operator=(const RingOwner &) = delete;
+
+            ~RingOwner()
+            {
+                if (this_thread_ring)
+                {
+                    this_thread_ring->thread_exited.store(true, std::memory_order_release);
+                    this_thread_ring = nullptr;
+                }
+                this_thread_ring_released = true;
+            }
+        };
+
+        thread_local RingOwner this_thread_ring_owner;
+
+        // Reads a value of type `T` from the front of `payload`, and removes it from there.
+        template <typename T>
+        [[nodiscard]] bool ReadValue(std::span<const std::byte> &payload, T &value)
+        {
+            if (payload.size() < sizeof value)
+                return false;
+            std::memcpy(&value, payload.data(), sizeof value);
+            payload = payload.subspan(sizeof value);
+            return true;
+        }
+
+        template <typename T>
+        [[nodiscard]] bool DecodeNumber(std::span<const std::byte> &payload, FormatSpec spec, std::string &out)
+        {
+            T value{};
+            if (!ReadValue(payload, value))
+                return false;
+
+            char buffer[64];
+            std::to_chars_result result;
+            if constexpr (std::is_integral_v<T>)
+                result = std::to_chars(buffer, buffer + sizeof buffer, value, spec == FormatSpec::none ? 10 : 16);
+            else
+                result = std::to_chars(buffer, buffer + sizeof buffer, value);
+            if (result.ec != std::errc{})
+                return false;
+
+            if (spec == FormatSpec::hex_upper)
+            {
+                for (char *ptr = buffer; ptr != result.ptr; ptr++)
+                {
+                    if (*ptr >= 'a' && *ptr <= 'f')
+                        *ptr = char(*ptr - 'a' + 'A');
+                }
+            }
+
+            out.append(buffer, result.ptr);
+            return true;
+        }
+
+        [[nodiscard]] bool DecodeArg(std::span<const std::byte> &payload, char kind, char size, FormatSpec spec, std::string &out)
+        {
+            switch (kind)
+            {
+              case 'b':
+                {
+                    bool value = false;
+                    if (!ReadValue(payload, value))
+                        return false;
+                    out += value ? "true" : "false";
+                    return true;
+                }
+              case 'c':
+                {
+                    char value = 0;
+                    if (!ReadValue(payload, value))
+                        return false;
+                    out += value;
+                    return true;
+                }
+              case 'i':
+                switch (size)
+                {
+                    case '1': return DecodeNumber<std::int8_t>(payload, spec, out);
+                    case '2': return DecodeNumber<std::int16_t>(payload, spec, out);
+                    case '4': return DecodeNumber<std::int32_t>(payload, spec, out);
+                    case '8': return DecodeNumber<std::int64_t>(payload, spec, out);
+                }
+                return false;
+              case 'u':
+                switch (size)
+                {
+                    case '1': return DecodeNumber<std::uint8_t>(payload, spec, out);
+                    case '2': return DecodeNumber<std::uint16_t>(payload, spec, out);
+                    case '4': return DecodeNumber<std::uint32_t>(payload, spec, out);
+                    case '8': return DecodeNumber<std::uint64_t>(payload, spec, out);
+                }
+                return false;
+              case 'f':
+                switch (size)
+                {
+                    case '4': return DecodeNumber<float>(payload, spec, out);
+                    case '8': return DecodeNumber<double>(payload, spec, out);
+                }
+                return false;
+              case 's':
+                {
+                    std::uint32_t str_size = 0;
+                    if (!ReadValue(payload, str_size) || payload.size() < str_size)
+                        return false;
+                    out.append(reinterpret_cast<const char *>(payload.data()), str_size);
+                    payload = payload.subspan(str_size);
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    const BinaryLogFormat *GetBinaryLogFormats()
+    {
+        return first_format.load(std::memory_order_acquire);
+    }
+
+    const BinaryLogFormat *FindBinaryLogFormat(std::uint64_t id)
+    {
+        for (const BinaryLogFormat *format = GetBinaryLogFormats(); format; format = format->next)
+        {
+            if (format->id == id)
+                return format;
+        }
+        return nullptr;
+    }
+
+    std::uint64_t DrainBinaryLog(std::vector<std::byte> &out)
+    {
+        Rings &rings = GetRings();
+        std::lock_guard lock(rings.mutex);
+
+        std::uint64_t num_dropped = 0;
+
+        detail::BinaryLog::Ring **link = &rings.first;
+        while (*link)
+        {
+            detail::BinaryLog::Ring &ring = **link;
+
+            // Must check this before reading `write_pos`, to make sure we see all the writes before the thread exited.
+            const bool exited = ring.thread_exited.load(std::memory_order_acquire);
+
+            const std::size_t r = ring.read_pos.load(std::memory_order_relaxed);
+            const std::size_t w = ring.write_pos.load(std::memory_order_acquire);
+
+            // The records are stored back to back, so we can copy the bytes as is.
+            const std::size_t offset = r & (ring.capacity - 1);
+            const std::size_t size = w - r;
+            const std::size_t first_part = std::min(size, ring.capacity - offset);
+            out.insert(out.end(), ring.data.get() + offset, ring.data.get() + offset + first_part);
+            out.insert(out.end(), ring.data.get(), ring.data.get() + (size - first_part));
+
+            ring.read_pos.store(w, std::memory_order_release);
+            num_dropped += ring.num_dropped.exchange(0, std::memory_order_relaxed);
+
+            if (exited)
+            {
+                *link = ring.next;
+                delete &ring;
+            }
+            else
+            {
+                link = &ring.next;
+            }
+        }
+
+        return num_dropped;
+    }
+
+    bool DecodeBinaryLogRecord(const BinaryLogFormat &format, std::span<const std::byte> payload, std::string &out)
+    {
+        std::size_t arg_index = 0;
+        bool ok = true;
+
+        ok = ParseFormatString(format.format,
+            [&](char ch){out += ch;},
+            [&](FormatSpec spec)
+            {
+                if (!ok || arg_index * 2 + 1 >= format.arg_types.size())
+                {
+                    ok = false;
+                    return;
+                }
+                ok = DecodeArg(payload, format.arg_types[arg_index * 2], format.arg_types[arg_index * 2 + 1], spec, out);
+                arg_index++;
+            }
+        ) && ok;
+
+        return ok && payload.empty() && arg_index * 2 == format.arg_types.size();
+    }
+
+    namespace detail::BinaryLog
+    {
+        void RegisterFormat(BinaryLogFormat &format)
+        {
+            const BinaryLogFormat *next = first_format.load(std::memory_order_relaxed);
+            do
+                format.next = next;
+            while (!first_format.compare_exchange_weak(next, &format, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        Ring *ThisThreadRing()
+        {
+            if (!this_thread_ring)
+            {
+                if (this_thread_ring_released)
+                    return nullptr;
+
+                (void)&this_thread_ring_owner; // Construct the owner, which schedules its destructor.
+
+                Ring *ring = new Ring;
+
+                Rings &rings = GetRings();
+                std::lock_guard lock(rings.mutex);
+                ring->next = rings.first;
+                rings.first = ring;
+
+                this_thread_ring = ring;
+            }
+            return this_thread_ring;
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include "em/meta/profile_zone.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace em::Meta
+{
+    namespace detail::ProfileZones
+    {
+        constinit thread_local Counters this_thread_counters[EM_PROFILE_ZONES_MAX + 1];
+    }
+
+    namespace
+    {
+        struct Zones
+        {
+            std::mutex mutex;
+
+            // The number of used slots, including the unused slot 0.
+            std::atomic<std::size_t> num_slots = 1;
+
+            zstring_view names[EM_PROFILE_ZONES_MAX + 1];
+
+            std::atomic<std::uint64_t> total_counts[EM_PROFILE_ZONES_MAX + 1]{};
+            std::atomic<std::uint64_t> total_ticks[EM_PROFILE_ZONES_MAX + 1]{};
+        };
+
+        [[nodiscard]] Zones &GetZones()
+        {
+            // Intentionally leaked, to allow flushing during static destruction.
+            static Zones &ret = *new Zones;
+            return ret;
+        }
+
+        // Flushes the counters when the thread exits.
+        struct ExitFlusher
+        {
+            ExitFlusher() = default;
+            ExitFlusher(const ExitFlusher &) = delete;
+            ExitFlusher &operator=(const ExitFlusher &) = delete;
+
+            ~ExitFlusher()
+            {
+                FlushProfileZones();
+            }
+        };
+    }
+
+    void FlushProfileZones()
+    {
+        #if EM_PROFILE_ZONES
+        thread_local ExitFlusher exit_flusher;
+        (void)exit_flusher;
+
+        Zones &zones = GetZones();
+        const std::size_t num_slots = zones.num_slots.load(std::memory_order_acquire);
+        for (std::size_t i = 1; i < num_slots; i++)
+        {
+            detail::ProfileZones::Counters &counters = detail::ProfileZones::this_thread_counters[i];
+            if (counters.count == 0)
+                continue;
+            zones.total_counts[i].fetch_add(counters.count, std::memory_order_relaxed);
+            zones.total_ticks[i].fetch_add(counters.ticks, std::memory_order_relaxed);
+            counters = {};
+        }
+        #endif
+    }
+
+    std::vector<ProfileZoneStats> GetProfileZoneStats()
+    {
+        std::vector<ProfileZoneStats> ret;
+
+        Zones &zones = GetZones();
+        const std::size_t num_slots = zones.num_slots.load(std::memory_order_acquire);
+        ret.reserve(num_slots - 1);
+        for (std::size_t i = 1; i < num_slots; i++)
+        {
+            ret.push_back({
+                .name = zones.names[i],
+                .count = zones.total_counts[i].load(std::memory_order_relaxed),
+                .ticks = zones.total_ticks[i].load(std::memory_order_relaxed),
+            });
+        }
+
+        return ret;
+    }
+
+    void ResetProfileZoneStats()
+    {
+        Zones &zones = GetZones();
+        const std::size_t num_slots = zones.num_slots.load(std::memory_order_acquire);
+        for (std::size_t i = 1; i < num_slots; i++)
+        {
+            zones.total_counts[i].store(0, std::memory_order_relaxed);
+            zones.total_ticks[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::string DumpProfileZones()
+    {
+        std::vector<ProfileZoneStats> stats = GetProfileZoneStats();
+        std::stable_sort(stats.begin(), stats.end(), [](const ProfileZoneStats &a, const ProfileZoneStats &b){return a.ticks > b.ticks;});
+
+        std::size_t name_width = 4;
+        for (const ProfileZoneStats &zone : stats)
+            name_width = std::max(name_width, zone.name.size());
+
+        std::string ret;
+
+        auto AppendRow = [&](std::string_view name, std::string_view count, std::string_view ticks, std::string_view average)
+        {
+            ret += name;
+            ret.append(name_width - name.size() + 2, ' ');
+            for (std::string_view column : {count, ticks, average})
+            {
+                ret.append(column.size() < 16 ? 16 - column.size() : 0, ' ');
+                ret += column;
+            }
+            ret += '\n';
+        };
+
+        AppendRow("zone", "count", "ticks", "ticks/call");
+        for (const ProfileZoneStats &zone : stats)
+            AppendRow(zone.name, std::to_string(zone.count), std::to_string(zone.ticks), std::to_string(zone.count ? zone.ticks / zone.count : 0));
+
+        return ret;
+    }
+
+    namespace detail::ProfileZones
+    {
+        std::size_t RegisterZone(zstring_view name)
+        {
+            Zones &zones = GetZones();
+            std::lock_guard lock(zones.mutex);
+
+            const std::size_t slot = zones.num_slots.load(std::memory_order_relaxed);
+            if (slot > EM_PROFILE_ZONES_MAX)
+                return 0;
+
+            zones.names[slot] = name;
+            zones.num_slots.store(slot + 1, std::memory_order_release);
+            return slot;
+        }
+    }
+}
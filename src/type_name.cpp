@@ -2,10 +2,56 @@
 
 #include <cppdecl/type_name.h>
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
 namespace em::Meta
 {
+    namespace
+    {
+        // The interned names. The map is node-based, so the strings never move after being inserted.
+        struct InternedTypeNames
+        {
+            std::shared_mutex mutex;
+            std::unordered_map<std::type_index, const std::string> map;
+        };
+
+        [[nodiscard]] InternedTypeNames &GetInternedTypeNames()
+        {
+            // Intentionally leaked, to make the names usable during static destruction.
+            static InternedTypeNames &ret = *new InternedTypeNames;
+            return ret;
+        }
+    }
+
     std::string TypeNameDynamic(std::type_index type)
     {
         return cppdecl::TypeNameDynamic(type);
     }
+
+    zstring_view TypeNameDynamicInterned(std::type_index type)
+    {
+        InternedTypeNames &names = GetInternedTypeNames();
+
+        { // Fast path.
+            std::shared_lock lock(names.mutex);
+            auto it = names.map.find(type);
+            if (it != names.map.end())
+                return it->second;
+        }
+
+        // Demangle outside of the lock. If another thread beats us to it, we just discard our copy.
+        std::string name = TypeNameDynamic(type);
+
+        std::unique_lock lock(names.mutex);
+        return names.map.try_emplace(type, std::move(name)).first->second;
+    }
+
+    void PrewarmTypeNames(std::span<const std::type_index> types)
+    {
+        for (std::type_index type : types)
+            (void)TypeNameDynamicInterned(type);
+    }
 }
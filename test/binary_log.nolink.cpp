@@ -0,0 +1,39 @@
+#include "em/meta/binary_log.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace em::Meta;
+
+// Argument types.
+static_assert(binary_loggable<bool> && binary_loggable<char> && binary_loggable<std::int16_t> && binary_loggable<std::uint64_t>);
+static_assert(binary_loggable<float> && binary_loggable<double>);
+static_assert(binary_loggable<const char *> && binary_loggable<char[4]> && binary_loggable<std::string_view> && binary_loggable<std::string>);
+static_assert(!binary_loggable<void *> && !binary_loggable<int *>);
+struct NotLoggable {};
+static_assert(!binary_loggable<NotLoggable>);
+
+// Argument type codes.
+static_assert(detail::BinaryLog::ArgType<bool>::value.view() == "b1");
+static_assert(detail::BinaryLog::ArgType<char>::value.view() == "c1");
+static_assert(detail::BinaryLog::ArgType<std::int32_t>::value.view() == "i4");
+static_assert(detail::BinaryLog::ArgType<std::uint8_t>::value.view() == "u1");
+static_assert(detail::BinaryLog::ArgType<std::uint64_t>::value.view() == "u8");
+static_assert(detail::BinaryLog::ArgType<float>::value.view() == "f4");
+static_assert(detail::BinaryLog::ArgType<double>::value.view() == "f8");
+static_assert(detail::BinaryLog::ArgType<std::string>::value.view() == "s0");
+
+// Checking the arguments against the format string.
+template <ConstString Fmt, typename ...P>
+concept CanLog = requires(const P &... args){BinaryLog<Fmt>(args...);};
+static_assert(CanLog<"">);
+static_assert(CanLog<"{} {}", int, const char *>);
+static_assert(CanLog<"{:x} {:X}", std::uint32_t, short>);
+static_assert(!CanLog<"{}", int, int>); // Wrong argument count.
+static_assert(!CanLog<"{} {}", int>);
+static_assert(!CanLog<"{:x}", float>); // Wrong spec.
+static_assert(!CanLog<"{:X}", std::string_view>);
+static_assert(!CanLog<"{:x}", bool>);
+static_assert(!CanLog<"{", int>); // Invalid format string.
+static_assert(!CanLog<"{}", NotLoggable>);
@@ -0,0 +1,59 @@
+#include "em/meta/bit_packed.h"
+
+#include <array>
+#include <cstdint>
+
+using namespace em::Meta;
+
+enum class Color : std::uint8_t {red, green, blue};
+
+using Small = BitPacked<TypeList<BitField<"a", std::uint8_t, 3>, BitField<"b", bool, 1>, BitField<"c", Color, 2>>>;
+using Large = BitPacked<TypeList<BitField<"x", std::uint32_t, 30>, BitField<"y", std::int64_t, 40>, BitField<"z", std::int8_t, 5>>>;
+
+// The layout.
+static_assert(Small::total_bits == 6 && std::is_same_v<Small::word_type, std::uint8_t> && sizeof(Small) == 1);
+static_assert(Large::total_bits == 75 && std::is_same_v<Large::word_type, std::uint64_t> && sizeof(Large) == 16);
+static_assert(sizeof(BitPacked<TypeList<BitField<"a", int, 17>>>) == 4);
+static_assert(Large::offsets == std::array<std::size_t, 3>{0, 30, 70});
+static_assert(Large::index_of<"y"> == 1);
+template <typename T, ConstString Name>
+concept HasField = requires{T::template index_of<Name>;};
+static_assert(HasField<Large, "y"> && !HasField<Large, "w">);
+static_assert(!HasField<BitPacked<TypeList<BitField<"a", int, 1>, BitField<"a", int, 1>>>, "a">);
+
+// Getting and setting.
+static_assert([]{
+    Small s(5, true, Color::blue);
+    return s.get<0>() == 5 && s.get<"b">() && s.get<"c">() == Color::blue;
+}());
+static_assert([]{
+    Small s;
+    s.set<"a">(9); // Truncated to 3 bits.
+    s.set<"c">(Color::green);
+    return s.get<"a">() == 1 && !s.get<"b">() && s.get<"c">() == Color::green;
+}());
+
+// Fields straddling the words, and sign extension.
+static_assert([]{
+    Large l(0x3fffffff, -123456789012, -16);
+    bool ok = l.get<"x">() == 0x3fffffff && l.get<"y">() == -123456789012 && l.get<"z">() == -16;
+    l.set<"y">(549755813887); // The largest positive value.
+    ok = ok && l.get<"x">() == 0x3fffffff && l.get<"y">() == 549755813887 && l.get<"z">() == -16;
+    l.set<"x">(0);
+    return ok && l.get<"x">() == 0 && l.get<"y">() == 549755813887 && l == Large(0, 549755813887, -16);
+}());
+static_assert([]{
+    BitPacked<TypeList<BitField<"a", std::uint8_t, 7>, BitField<"b", std::uint64_t, 64>>> p;
+    p.set<"b">(0xfedcba9876543210);
+    return p.get<"a">() == 0 && p.get<"b">() == 0xfedcba9876543210;
+}());
+
+// Unpacking a column.
+static_assert([]{
+    const Large records[] = {Large(1, -1, 2), Large(3, 4, -5), Large(6, -7, 8)};
+    std::array<std::int64_t, 3> y{};
+    std::array<std::int8_t, 3> z{};
+    Large::UnpackColumn<"y">(records, y);
+    Large::UnpackColumn<2>(records, z);
+    return y == std::array<std::int64_t, 3>{-1, 4, -7} && z == std::array<std::int8_t, 3>{2, -5, 8};
+}());
@@ -0,0 +1,56 @@
+#include "em/meta/compact_variant.h"
+#include "em/meta/visit.h"
+
+#include <cstdint>
+#include <string>
+
+using V = em::Meta::CompactVariant<std::int32_t, float, char>;
+
+static_assert(std::is_same_v<V::index_type, std::uint8_t>);
+static_assert(sizeof(V) == 8);
+static_assert(std::is_trivially_copyable_v<V> && std::is_trivially_destructible_v<V>);
+static_assert(!std::is_trivially_copyable_v<em::Meta::CompactVariant<int, std::string>>);
+static_assert(std::is_copy_constructible_v<em::Meta::CompactVariant<int, std::string>>);
+
+static_assert(V::index_of<float> == 1);
+static_assert(std::is_constructible_v<V, float>);
+static_assert(!std::is_constructible_v<V, double>); // No implicit conversions.
+static_assert(!std::is_constructible_v<V, const char *>);
+static_assert(std::is_constructible_v<V, std::in_place_index_t<2>, int>);
+
+// Bigger index types.
+template <std::size_t ...I>
+static constexpr std::size_t many_alternatives_index_size(std::index_sequence<I...>) {return sizeof(typename em::Meta::CompactVariant<std::integral_constant<std::size_t, I>...>::index_type);}
+static_assert(many_alternatives_index_size(std::make_index_sequence<255>{}) == 1);
+static_assert(many_alternatives_index_size(std::make_index_sequence<256>{}) == 2);
+
+// Spare bytes.
+struct WithSpareByte
+{
+    std::uint16_t a;
+    std::uint8_t b;
+    // The last byte is padding, which doesn't affect the value.
+};
+static_assert(sizeof(WithSpareByte) == 4);
+template <> struct em::Meta::CompactVariantSpareByte<WithSpareByte> {static constexpr std::size_t offset = 3;};
+using S = em::Meta::CompactVariant<WithSpareByte, std::uint16_t, char>;
+static_assert(S::index_in_spare_byte);
+static_assert(sizeof(S) == 4);
+static_assert(!em::Meta::CompactVariant<WithSpareByte, std::uint32_t>::index_in_spare_byte); // `uint32_t` overlaps the byte.
+// Only const access to the alternatives that contain the index, since modifying them could overwrite it. `Modify()` must be used instead.
+static_assert(!S::mutable_alternative<0> && S::mutable_alternative<1>);
+static_assert(std::is_same_v<decltype(std::declval<S &>().get<0>()), const WithSpareByte &>);
+static_assert(std::is_same_v<decltype(std::declval<S &&>().get<WithSpareByte>()), const WithSpareByte &&>);
+static_assert(std::is_same_v<decltype(std::declval<S &>().get_if<0>()), const WithSpareByte *>);
+static_assert(std::is_same_v<decltype(std::declval<S &>().emplace<0>()), const WithSpareByte &>);
+static_assert(std::is_same_v<decltype(std::declval<S &>().get<1>()), std::uint16_t &>);
+static_assert(std::is_same_v<decltype(std::declval<S &>().Modify<0>([](WithSpareByte &x) -> int {return x.a;})), int>);
+static_assert(std::is_same_v<decltype(std::declval<V &>().get<1>()), float &>); // Separate index.
+
+// Lists.
+static_assert(std::is_same_v<em::Meta::CompactVariant<em::Meta::TypeList<int, float>>::types, em::Meta::TypeList<int, float>>);
+static_assert(std::variant_size_v<em::Meta::CompactVariant<em::Meta::TypeList<int, float>>> == 2);
+static_assert(std::is_same_v<std::variant_alternative_t<1, V>, float>);
+
+// Visiting.
+static_assert(std::is_same_v<decltype(em::Meta::Visit([](auto &x) -> auto & {return x;}, std::declval<em::Meta::CompactVariant<int> &>())), int &>);
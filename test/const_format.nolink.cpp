@@ -0,0 +1,41 @@
+#include "em/meta/const_format.h"
+
+#include <cstdint>
+#include <string_view>
+
+template <em::Meta::ConstString Fmt>
+constexpr std::string_view Format(char *buffer, std::size_t size, const auto &... args)
+{
+    char *end = em::Meta::FormatTo<Fmt>(std::span(buffer, size), args...);
+    return end ? std::string_view(buffer, end) : "<overflow>";
+}
+
+static_assert([]{char buf[64]; return Format<"">(buf, 64) == "";}());
+static_assert([]{char buf[64]; return Format<"{{a}}">(buf, 64) == "{a}";}());
+static_assert([]{char buf[64]; return Format<"a{}b{}c{}">(buf, 64, "x", 'y', true) == "axbyctrue";}());
+static_assert([]{char buf[64]; return Format<"{}{}">(buf, 64, std::string_view("x"), false) == "xfalse";}());
+static_assert([]{char buf[4]; return Format<"ab{}">(buf, 4, "xyz") == "<overflow>";}());
+
+// Numbers.
+static_assert([]{char buf[64]; return Format<"{}">(buf, 64, -42) == "-42";}());
+static_assert([]{char buf[64]; return Format<"{} {}">(buf, 64, 0u, std::uint64_t(18446744073709551615u)) == "0 18446744073709551615";}());
+static_assert([]{char buf[64]; return Format<"{:x}">(buf, 64, 255) == "ff";}());
+static_assert([]{char buf[64]; return Format<"{:X}">(buf, 64, 255) == "FF";}());
+static_assert([]{char buf[64]; return Format<"0x{:X}-{:x}">(buf, 64, std::uint16_t(0xbeef), -26) == "0xBEEF--1a";}());
+static_assert([]{char buf[2]; return Format<"{}">(buf, 2, 123) == "<overflow>";}());
+
+static_assert(em::Meta::ParseFormatString("{}{:x}{:X}{{}}", [](char){}, [](em::Meta::FormatSpec){}));
+static_assert(!em::Meta::ParseFormatString("{", [](char){}, [](em::Meta::FormatSpec){}));
+static_assert(!em::Meta::ParseFormatString("}", [](char){}, [](em::Meta::FormatSpec){}));
+static_assert(!em::Meta::ParseFormatString("{:y}", [](char){}, [](em::Meta::FormatSpec){}));
+
+static_assert(em::Meta::formattable_with_spec<int, em::Meta::FormatSpec::hex>);
+static_assert(!em::Meta::formattable_with_spec<float, em::Meta::FormatSpec::hex>);
+static_assert(!em::Meta::formattable_with_spec<bool, em::Meta::FormatSpec::hex>);
+static_assert(!em::Meta::formattable_with_spec<char, em::Meta::FormatSpec::hex_upper>);
+static_assert(!em::Meta::formattable_with_spec<double, em::Meta::FormatSpec::hex_upper>);
+static_assert(!em::Meta::formattable_with_spec<const char *, em::Meta::FormatSpec::hex>);
+static_assert(em::Meta::formattable_with_spec<unsigned long long, em::Meta::FormatSpec::hex_upper>);
+static_assert(em::Meta::formattable_with_spec<float>); // Floating-point `std::to_chars()` isn't constexpr, so floats are only checked here.
+static_assert(em::Meta::formattable_with_spec<const char *>);
+static_assert(!em::Meta::formattable_with_spec<void *>);
@@ -0,0 +1,48 @@
+#include "em/meta/const_pattern.h"
+
+using em::Meta::ConstGlob;
+using em::Meta::ConstRegex;
+
+static_assert(ConstRegex<"abc">::Match("abc"));
+static_assert(!ConstRegex<"abc">::Match("ab"));
+static_assert(!ConstRegex<"abc">::Match("abcd"));
+static_assert(ConstRegex<"">::Match(""));
+static_assert(!ConstRegex<"">::Match("a"));
+
+static_assert(ConstRegex<"a*b+c?">::Match("b"));
+static_assert(ConstRegex<"a*b+c?">::Match("aabbc"));
+static_assert(!ConstRegex<"a*b+c?">::Match("aac"));
+static_assert(ConstRegex<"(ab|cd)*">::Match(""));
+static_assert(ConstRegex<"(ab|cd)*">::Match("abcdab"));
+static_assert(!ConstRegex<"(ab|cd)*">::Match("abc"));
+static_assert(ConstRegex<"x(|y)z">::Match("xz"));
+static_assert(ConstRegex<"x(|y)z">::Match("xyz"));
+
+static_assert(ConstRegex<"[a-z_][a-z0-9_]*\\.(cpp|h)">::Match("foo_1.cpp"));
+static_assert(!ConstRegex<"[a-z_][a-z0-9_]*\\.(cpp|h)">::Match("1foo.cpp"));
+static_assert(!ConstRegex<"[a-z_][a-z0-9_]*\\.(cpp|h)">::Match("foo.hpp"));
+static_assert(ConstRegex<"[^0-9]+">::Match("abc"));
+static_assert(!ConstRegex<"[^0-9]+">::Match("a1c"));
+static_assert(ConstRegex<"[]a-]+">::Match("]-a"));
+static_assert(ConstRegex<"\\d+\\s\\w+">::Match("42 ok_1"));
+static_assert(!ConstRegex<"\\d+\\s\\w+">::Match("42  ok"));
+static_assert(ConstRegex<"a.c">::Match("a/c"));
+
+static_assert(ConstGlob<"*.cpp">::Match("foo.cpp"));
+static_assert(ConstGlob<"*.cpp">::Match(".cpp"));
+static_assert(!ConstGlob<"*.cpp">::Match("src/foo.cpp"));
+static_assert(ConstGlob<"src/**.cpp">::Match("src/a/b/foo.cpp"));
+static_assert(ConstGlob<"src/**/*.cpp">::Match("src/foo.cpp")); // `**/` matches zero or more directories.
+static_assert(ConstGlob<"src/**/*.cpp">::Match("src/a/foo.cpp"));
+static_assert(ConstGlob<"src/**/*.cpp">::Match("src/a/b/foo.cpp"));
+static_assert(!ConstGlob<"src/**/*.cpp">::Match("srcfoo.cpp"));
+static_assert(!ConstGlob<"src/**/*.cpp">::Match("src/a/foo.h"));
+static_assert(ConstGlob<"**/foo">::Match("foo"));
+static_assert(ConstGlob<"**/foo">::Match("a/b/foo"));
+static_assert(!ConstGlob<"**/foo">::Match("afoo"));
+static_assert(ConstGlob<"file?.[ch]">::Match("file1.h"));
+static_assert(!ConstGlob<"file?.[ch]">::Match("file/.h"));
+static_assert(!ConstGlob<"file?.[!ch]">::Match("file1.h"));
+static_assert(ConstGlob<"file?.[!ch]">::Match("file1.x"));
+static_assert(ConstGlob<"\\*">::Match("*"));
+static_assert(!ConstGlob<"\\*">::Match("a"));
@@ -0,0 +1,35 @@
+#include "em/meta/const_string.h"
+
+#include <type_traits>
+
+using namespace em::Meta;
+
+// --- ConstStringConcat()
+
+constexpr auto concat_empty = ConstStringConcat();
+static_assert(concat_empty.view() == "");
+constexpr auto concat_mixed = ConstStringConcat(ConstString("ab"), "cd", "ef"_c, "", ConstString("g"));
+static_assert(concat_mixed.view() == "abcdefg");
+static_assert(std::is_same_v<decltype(ConstStringConcat(ConstString("ab"), "cd", "ef"_c)), ConstString<7>>);
+
+constexpr auto plus_1 = ConstString("ab") + ConstString("cd");
+constexpr auto plus_2 = ConstString("ab") + "cd";
+constexpr auto plus_3 = "ab" + ConstString("cd");
+static_assert(plus_1.view() == "abcd");
+static_assert(plus_2.view() == "abcd");
+static_assert(plus_3.view() == "abcd");
+
+
+// --- ConstStringBuilder
+
+constexpr auto built = ConstStringFromBuilder<[]{
+    ConstStringBuilder<32> b;
+    for (int i = 0; i < 3; i++)
+    {
+        b += "x";
+        b += char('0' + i);
+    }
+    return b;
+}>;
+static_assert(built.view() == "x0x1x2");
+static_assert(std::is_same_v<std::remove_const_t<decltype(built)>, ConstString<7>>);
@@ -0,0 +1,17 @@
+#include "em/meta/const_string_map.h"
+
+using em::Meta::operator""_c;
+
+using Map = em::Meta::ConstStringMap<"foo"_c, "bar"_c, "baz"_c, ""_c, "qux"_c, "quux"_c, "corge"_c, "grault"_c, "garply"_c, "waldo"_c>;
+static_assert(Map::Find("foo") == 0);
+static_assert(Map::Find("bar") == 1);
+static_assert(Map::Find("baz") == 2);
+static_assert(Map::Find("") == 3);
+static_assert(Map::Find("waldo") == 9);
+static_assert(Map::Find("fo") == Map::size);
+static_assert(Map::Find("fooo") == Map::size);
+static_assert(Map::Find("xyz") == Map::size);
+
+static_assert(em::Meta::ConstStringMap<>::Find("foo") == 0);
+static_assert(em::Meta::ConstStringMap<"a"_c>::Find("a") == 0);
+static_assert(em::Meta::ConstStringMap<"a"_c>::Find("b") == 1);
@@ -0,0 +1,23 @@
+#include "em/meta/const_string_trie.h"
+
+using em::Meta::operator""_c;
+
+using Trie = em::Meta::ConstStringTrie<"<"_c, "<="_c, "<<"_c, "<<="_c, "if"_c, "int"_c, "in"_c>;
+
+static_assert(Trie::MatchLongestPrefix("<").index == 0);
+static_assert(Trie::MatchLongestPrefix("<x").index == 0);
+static_assert(Trie::MatchLongestPrefix("<x").length == 1);
+static_assert(Trie::MatchLongestPrefix("<=").index == 1);
+static_assert(Trie::MatchLongestPrefix("<<").index == 2);
+static_assert(Trie::MatchLongestPrefix("<<=1").index == 3);
+static_assert(Trie::MatchLongestPrefix("<<=1").length == 3);
+static_assert(Trie::MatchLongestPrefix("inta").index == 5);
+static_assert(Trie::MatchLongestPrefix("inx").index == 6);
+static_assert(Trie::MatchLongestPrefix("inx").length == 2);
+static_assert(!Trie::MatchLongestPrefix("i"));
+static_assert(!Trie::MatchLongestPrefix(""));
+static_assert(!Trie::MatchLongestPrefix("x<"));
+
+static_assert(em::Meta::ConstStringTrie<""_c, "a"_c>::MatchLongestPrefix("b").index == 0);
+static_assert(em::Meta::ConstStringTrie<""_c, "a"_c>::MatchLongestPrefix("ab").index == 1);
+static_assert(!em::Meta::ConstStringTrie<>::MatchLongestPrefix("a"));
@@ -129,3 +129,33 @@ static_assert(em::Meta::SameTypeAndConstructibleFromDesc<int>(em::Meta::type_to_
 static_assert(em::Meta::SameTypeAndConstructibleFromDesc<int &>(em::Meta::type_to_desc<int &>));
 static_assert(!em::Meta::SameTypeAndConstructibleFromDesc<int &>(em::Meta::type_to_desc<int &&>));
 static_assert(!em::Meta::SameTypeAndConstructibleFromDesc<int>(em::Meta::type_to_desc<float>));
+
+static_assert(em::Meta::SameTypeAndConstructibleFromDesc<int>(em::Meta::type_to_desc_id<int>));
+static_assert(em::Meta::SameTypeAndConstructibleFromDesc<int &>(em::Meta::type_to_desc_id<int &>));
+static_assert(!em::Meta::SameTypeAndConstructibleFromDesc<int &>(em::Meta::type_to_desc_id<int &&>));
+static_assert(!em::Meta::SameTypeAndConstructibleFromDesc<int>(em::Meta::type_to_desc_id<float>));
+static_assert(em::Meta::SameTypeAndDescIsConstructibleFrom<int &>(em::Meta::type_to_desc_id<const int &>));
+static_assert(!em::Meta::SameTypeAndDescIsConstructibleFrom<const int &>(em::Meta::type_to_desc_id<int &>));
+
+struct NonCopyable
+{
+    NonCopyable() = default;
+    NonCopyable(const NonCopyable &) = delete;
+    NonCopyable(NonCopyable &&) = default;
+};
+
+static_assert(em::Meta::type_to_param_desc<int>.accepts == 0b111111);
+static_assert(em::Meta::type_to_param_desc<const int &>.accepts == 0b111111);
+static_assert(em::Meta::type_to_param_desc<int &>.accepts == 0b000100);
+static_assert(em::Meta::type_to_param_desc<NonCopyable>.accepts == 0b010001);
+
+constexpr em::Meta::CvrefParamDesc test_params[] = {em::Meta::type_to_param_desc<int>, em::Meta::type_to_param_desc<float &>, em::Meta::type_to_param_desc<const int &>};
+constexpr em::Meta::CvrefFlagsAndTypeId test_args_ok[] = {em::Meta::type_to_desc_id<int &>, em::Meta::type_to_desc_id<float &>, em::Meta::type_to_desc_id<int>};
+constexpr em::Meta::CvrefFlagsAndTypeId test_args_bad_type[] = {em::Meta::type_to_desc_id<int &>, em::Meta::type_to_desc_id<float &>, em::Meta::type_to_desc_id<float>};
+constexpr em::Meta::CvrefFlagsAndTypeId test_args_bad_ref[] = {em::Meta::type_to_desc_id<int &>, em::Meta::type_to_desc_id<float &&>, em::Meta::type_to_desc_id<int>};
+
+static_assert(em::Meta::FindFirstMismatchingArg(test_params, test_args_ok) == 3);
+static_assert(em::Meta::FindFirstMismatchingArg(test_params, test_args_bad_type) == 2);
+static_assert(em::Meta::FindFirstMismatchingArg(test_params, test_args_bad_ref) == 1);
+static_assert(em::Meta::ArgsMatchParams(test_params, test_args_ok));
+static_assert(!em::Meta::ArgsMatchParams(test_params, std::span(test_args_ok).first(2)));
@@ -0,0 +1,36 @@
+#include "em/meta/dynamic_overload.h"
+
+#include <type_traits>
+#include <utility>
+
+using Resolver = em::Meta::DynamicOverloadResolver<em::Meta::TypeList<
+    em::Meta::TypeList<int &>,
+    em::Meta::TypeList<int>,
+    em::Meta::TypeList<float, const int &>,
+    em::Meta::TypeList<>
+>>;
+
+constexpr em::Meta::CvrefFlagsAndTypeId args_lvalue[] = {em::Meta::type_to_desc_id<int &>};
+constexpr em::Meta::CvrefFlagsAndTypeId args_rvalue[] = {em::Meta::type_to_desc_id<int>};
+constexpr em::Meta::CvrefFlagsAndTypeId args_two[] = {em::Meta::type_to_desc_id<float &>, em::Meta::type_to_desc_id<int &&>};
+constexpr em::Meta::CvrefFlagsAndTypeId args_bad[] = {em::Meta::type_to_desc_id<double>};
+
+static_assert(Resolver::ResolveUncached(args_lvalue) == 0);
+static_assert(Resolver::ResolveUncached(args_rvalue) == 1);
+static_assert(Resolver::ResolveUncached(args_two) == 2);
+static_assert(Resolver::ResolveUncached({}) == 3);
+static_assert(Resolver::ResolveUncached(args_bad) == Resolver::no_match);
+
+// Which candidates can accept the same arguments. `int &` and `int` both accept an `int &` argument.
+static_assert(Resolver::shadowed_by[1][0]);
+static_assert(!Resolver::shadowed_by[2][0] && !Resolver::shadowed_by[2][1]);
+static_assert(!Resolver::shadowed_by[3][0] && !Resolver::shadowed_by[3][1] && !Resolver::shadowed_by[3][2]);
+
+// A cached result is only reused if no earlier candidate accepts the same arguments, even on a hash collision.
+static_assert(Resolver::NotShadowed(0, args_lvalue));
+static_assert(!Resolver::NotShadowed(1, args_lvalue));
+static_assert(Resolver::NotShadowed(1, args_rvalue));
+static_assert(Resolver::NotShadowed(2, args_two));
+
+// `Resolve()` uses atomics and can't run at compile-time, the above is the logic it uses on a cache hit.
+static_assert(std::is_same_v<decltype(std::declval<Resolver &>().Resolve(args_lvalue)), std::size_t>);
@@ -0,0 +1,55 @@
+#include "em/meta/enum_containers.h"
+#include "em/meta/cvref_extras.h"
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+    enum class Color {red, green, blue};
+    enum class Sparse : int {a = -1000, b = 0, c = 1000};
+
+    using Cvref = em::Meta::ValueList<em::Meta::CvrefFlags::none, em::Meta::CvrefFlags::const_, em::Meta::CvrefFlags::lvalue_ref, em::Meta::CvrefFlags::const_lvalue_ref, em::Meta::CvrefFlags::rvalue_ref, em::Meta::CvrefFlags::const_rvalue_ref>;
+}
+
+using em::Meta::EnumArray;
+using em::Meta::EnumSet;
+using em::Meta::CvrefFlags;
+
+static_assert(EnumSet<Color>::capacity == 3);
+static_assert(EnumSet<Color>{}.empty());
+static_assert(EnumSet<Color>{Color::red, Color::blue}.size() == 2);
+static_assert(EnumSet<Color>{Color::red, Color::blue}.Contains(Color::blue));
+static_assert(!EnumSet<Color>{Color::red, Color::blue}.Contains(Color::green));
+static_assert(!EnumSet<Color>{Color::red}.Contains(Color(42)));
+static_assert(~EnumSet<Color>{Color::red} == EnumSet<Color>{Color::green, Color::blue});
+static_assert((EnumSet<Color>{Color::red, Color::green} & EnumSet<Color>{Color::green, Color::blue}) == EnumSet<Color>{Color::green});
+static_assert((EnumSet<Color>{Color::red} | EnumSet<Color>{Color::blue}) == EnumSet<Color>{Color::blue, Color::red});
+static_assert((EnumSet<Color>::All() - EnumSet<Color>{Color::red}).size() == 2);
+static_assert(EnumSet<Color>::All().ContainsAll(EnumSet<Color>{Color::red}));
+static_assert(!EnumSet<Color>{Color::red}.Intersects(EnumSet<Color>{Color::blue}));
+static_assert([]{
+    EnumSet<Color> set{Color::blue, Color::red};
+    if (!set.Erase(Color::red) || set.Erase(Color::red) || !set.Insert(Color::green) || set.Insert(Color::green))
+        return false;
+    std::array<Color, 2> expected = {Color::green, Color::blue};
+    return std::equal(set.begin(), set.end(), expected.begin(), expected.end());
+}());
+
+static_assert(EnumSet<CvrefFlags, Cvref>{CvrefFlags::const_lvalue_ref}.Contains(CvrefFlags::const_lvalue_ref));
+static_assert(!EnumSet<CvrefFlags, Cvref>::All().Contains(CvrefFlags::ref_mask));
+static_assert(EnumSet<CvrefFlags, Cvref>::All().size() == 6);
+
+static_assert(EnumSet<Sparse, em::Meta::ValueList<Sparse::c, Sparse::a, Sparse::b>>{Sparse::a}.Contains(Sparse::a));
+static_assert(!EnumSet<Sparse, em::Meta::ValueList<Sparse::c, Sparse::a, Sparse::b>>{Sparse::a}.Contains(Sparse(1)));
+
+static_assert(EnumArray<Color, int>::size == 3);
+static_assert(EnumArray<Color, int>{{1, 2, 3}}[Color::blue] == 3);
+static_assert(EnumArray<Color, int>::KeyAt(1) == Color::green);
+static_assert(!EnumArray<Color, int>::HasKey(Color(3)));
+static_assert(EnumArray<Color, int>{}.Find(Color(3)) == nullptr);
+static_assert([]{
+    EnumArray<CvrefFlags, int, Cvref> arr;
+    arr[CvrefFlags::rvalue_ref] = 5;
+    return arr.elems[4] == 5 && *arr.Find(CvrefFlags::rvalue_ref) == 5;
+}());
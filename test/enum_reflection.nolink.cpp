@@ -0,0 +1,59 @@
+#include "em/meta/enum_reflection.h"
+
+#include <type_traits>
+
+namespace
+{
+    enum class Color {red, green = 3, blue, alias = 3, negative = -5};
+    enum Plain : unsigned char {plain_a = 1, plain_b = 200, plain_c};
+    enum class Empty : int {};
+}
+
+namespace Named
+{
+    enum class Fruit {apple, banana = 2};
+}
+
+using em::Meta::EnumFromString;
+using em::Meta::EnumIndex;
+using em::Meta::EnumToString;
+
+static_assert(em::Meta::enum_size<Color> == 4);
+static_assert(std::is_same_v<em::Meta::enum_values<Color>, em::Meta::ValueList<Color::negative, Color::red, Color::green, Color::blue>>);
+
+static_assert(EnumIndex(Color::negative) == 0);
+static_assert(EnumIndex(Color::blue) == 3);
+static_assert(EnumIndex(Color(1)) == 4);
+static_assert(EnumIndex(Color(1000)) == 4);
+
+static_assert(EnumToString(Color::red) == "red");
+static_assert(EnumToString(Color::negative) == "negative");
+static_assert(EnumToString(Color::alias) == "green");
+static_assert(EnumToString(Color(2)).empty());
+
+static_assert(EnumFromString<Color>("blue") == Color::blue);
+static_assert(EnumFromString<Color>("negative") == Color::negative);
+static_assert(!EnumFromString<Color>("bluee"));
+static_assert(!EnumFromString<Color>(""));
+
+// Both enums in named namespaces and in anonymous namespaces (which is where `Color` is) get unqualified names.
+static_assert(em::Meta::enum_size<Named::Fruit> == 2);
+static_assert(EnumToString(Named::Fruit::banana) == "banana");
+static_assert(EnumToString(Named::Fruit(1)).empty());
+#ifndef _MSC_VER
+// What Clang prints for the enums in anonymous namespaces.
+static_assert(em::Meta::detail::EnumReflection::ExtractName("[V = (anonymous namespace)::Color::red]") == "red");
+static_assert(em::Meta::detail::EnumReflection::ExtractName("[V = ((anonymous namespace)::Color)5]").empty());
+static_assert(em::Meta::detail::EnumReflection::ExtractName("[V = (Named::Fruit)-1]").empty());
+#endif
+
+// The values outside of the default range aren't found.
+static_assert(em::Meta::enum_size<Plain> == 1);
+static_assert(EnumToString(plain_a) == "plain_a");
+static_assert(EnumToString(plain_b).empty());
+
+static_assert(em::Meta::enum_size<Empty> == 0);
+static_assert(EnumToString(Empty(0)).empty());
+static_assert(!EnumFromString<Empty>("x"));
+
+static_assert(!em::Meta::reflectable_enum<int>);
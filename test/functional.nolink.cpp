@@ -0,0 +1,57 @@
+#include "em/meta/functional.h"
+
+#include <string>
+
+// The order of operands.
+static constexpr auto concat = [](std::string a, std::string b){return "(" + a + b + ")";};
+static_assert(em::Meta::Fold(concat, "a", "b", "c", "d") == "(a(b(cd)))");
+static_assert(em::Meta::FoldLeft(concat, "a", "b") == "(ab)");
+static_assert(em::Meta::FoldLeft(concat, "a", "b", "c", "d") == "(((ab)c)d)");
+static_assert(em::Meta::FoldBalanced(concat, "a", "b") == "(ab)");
+static_assert(em::Meta::FoldBalanced(concat, "a", "b", "c") == "(a(bc))");
+static_assert(em::Meta::FoldBalanced(concat, "a", "b", "c", "d", "e") == "((ab)(c(de)))");
+
+// Noexcept propagation.
+static constexpr auto add = [](int a, int b) noexcept {return a + b;};
+static constexpr auto add_throwing = [](int a, int b){return a + b;};
+static_assert(em::Meta::FoldLeft(add, 1, 2, 3, 4) == 10);
+static_assert(em::Meta::FoldBalanced(add, 1, 2, 3, 4, 5) == 15);
+static_assert(noexcept(em::Meta::FoldLeft(add, 1, 2, 3)));
+static_assert(noexcept(em::Meta::FoldBalanced(add, 1, 2, 3)));
+static_assert(!noexcept(em::Meta::FoldLeft(add_throwing, 1, 2, 3)));
+static_assert(!noexcept(em::Meta::FoldBalanced(add_throwing, 1, 2, 3)));
+
+// SFINAE-friendliness.
+template <typename ...P> concept CanFoldLeft = requires{em::Meta::FoldLeft(add, P{}...);};
+template <typename ...P> concept CanFoldBalanced = requires{em::Meta::FoldBalanced(add, P{}...);};
+static_assert(CanFoldLeft<int, int, int> && !CanFoldLeft<int> && !CanFoldLeft<int, int, std::string>);
+static_assert(CanFoldBalanced<int, int, int> && !CanFoldBalanced<int> && !CanFoldBalanced<int, int, std::string>);
+
+// `FunctionRef`.
+static_assert(sizeof(em::Meta::FunctionRef<int(int)>) == sizeof(void *) * 2);
+static_assert(std::is_trivially_copyable_v<em::Meta::FunctionRef<int(int)>>);
+static_assert(em::Meta::FunctionRef<int(int, int)>(add)(1, 2) == 3);
+static_assert(noexcept(em::Meta::FunctionRef<int(int, int) noexcept>(add)(1, 2)));
+static_assert(std::is_constructible_v<em::Meta::FunctionRef<int(int, int)>, decltype(add_throwing) &>);
+static_assert(!std::is_constructible_v<em::Meta::FunctionRef<int(int, int) noexcept>, decltype(add_throwing) &>);
+static_assert(!std::is_constructible_v<em::Meta::FunctionRef<int(int, int)>, decltype(concat) &>);
+static_assert(std::is_constructible_v<em::Meta::FunctionRef<void(int, int)>, decltype(add) &>);
+
+// Mutable callables are called as lvalues, and keep their state.
+static_assert([]{int n = 0; auto counter = [&n](int x) mutable {n += x;}; em::Meta::FunctionRef<void(int)> r = counter; r(1); r(2); return n;}() == 3);
+
+// `FuncRef`s are unwrapped, and keep their forwarding rules.
+struct CategoryFunc
+{
+    constexpr int operator()() & {return 1;}
+    constexpr int operator()() && {return 2;}
+};
+static_assert([]{CategoryFunc f; return em::Meta::FunctionRef<int()>(em::Meta::FuncRef(f))();}() == 1);
+static_assert([]{CategoryFunc f; return em::Meta::FunctionRef<int()>(em::Meta::FuncRef(std::move(f)))();}() == 2);
+static_assert([]{CategoryFunc f; auto ref = em::Meta::FuncRef(std::move(f)); return em::Meta::FunctionRef<int()>(ref)();}() == 1);
+static_assert(em::Meta::FunctionRef<bool(int)>(em::Meta::MakeNegatedFuncRef([](int x){return x > 0;}))(-1));
+
+// Function pointers.
+constexpr int Negate(int x) {return -x;}
+static_assert(std::is_same_v<decltype(em::Meta::FunctionRef(&Negate)), em::Meta::FunctionRef<int(int)>>);
+static_assert(std::is_constructible_v<em::Meta::FunctionRef<long(short)>, decltype(Negate) &>);
@@ -0,0 +1,38 @@
+#include "em/meta/inplace_function.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using Func = em::Meta::InplaceFunction<int(int)>;
+using NothrowFunc = em::Meta::InplaceFunction<int(int) noexcept>;
+
+static_assert(sizeof(Func) == sizeof(void *) * 6);
+static_assert(std::is_nothrow_move_constructible_v<Func> && std::is_nothrow_move_assignable_v<Func>);
+static_assert(!std::is_copy_constructible_v<Func> && !std::is_copy_assignable_v<Func>);
+static_assert(std::is_nothrow_constructible_v<Func, std::nullptr_t>);
+
+// Signature checks.
+static_assert(std::is_constructible_v<Func, int (*)(int)>);
+static_assert(std::is_constructible_v<Func, int (*)(long)>);
+static_assert(!std::is_constructible_v<Func, int (*)(std::string)>);
+static_assert(std::is_constructible_v<em::Meta::InplaceFunction<void(int)>, int (*)(int)>);
+static_assert(!std::is_constructible_v<NothrowFunc, int (*)(int)>);
+static_assert(std::is_constructible_v<NothrowFunc, int (*)(int) noexcept>);
+
+// Move-only callables are accepted.
+static_assert(std::is_constructible_v<em::Meta::InplaceFunction<void()>, decltype([p = std::unique_ptr<int>()]{})>);
+
+// Size limits.
+static_assert(Func::fits<char[32]> && !Func::fits<char[33]>);
+static_assert(em::Meta::InplaceFunction<void(), 64>::fits<char[64]>);
+static_assert(!Func::fits<decltype([x = std::max_align_t{}, y = std::max_align_t{}, z = std::max_align_t{}](int){return 0;})>);
+
+// Callables that don't fit are rejected by the constructor constraints, rather than failing inside of it.
+using BigCallable = decltype([x = std::max_align_t{}, y = std::max_align_t{}, z = std::max_align_t{}](int){return 0;});
+static_assert(!std::is_constructible_v<Func, BigCallable>);
+static_assert(!std::is_convertible_v<BigCallable, Func>);
+static_assert(std::is_constructible_v<em::Meta::InplaceFunction<int(int), sizeof(BigCallable)>, BigCallable>);
+struct alignas(64) OverAligned {int operator()(int x) const {return x;}};
+static_assert(!std::is_constructible_v<em::Meta::InplaceFunction<int(int), 64>, OverAligned>);
+static_assert(std::is_constructible_v<em::Meta::InplaceFunction<int(int), 64, 64>, OverAligned>);
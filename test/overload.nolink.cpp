@@ -0,0 +1,27 @@
+#include "em/meta/overload.h"
+
+#include <string>
+
+static constexpr auto by_type = em::Meta::OverloadByType{
+    [](int) {return 1;},
+    [](const std::string &) {return 2;},
+    [](float &&) {return 3;},
+    [](char x) mutable noexcept {return int(x);},
+};
+
+static_assert(std::is_same_v<decltype(by_type)::param_types, em::Meta::TypeList<int, std::string, float, char>>);
+static_assert(decltype(by_type)::index_of<const int &> == 0);
+static_assert(decltype(by_type)::index_of<std::string> == 1);
+
+static_assert(by_type(42) == 1);
+static_assert(by_type(std::string("x")) == 2);
+static_assert(by_type(1.5f) == 3);
+
+// No implicit conversions.
+static_assert(!std::is_invocable_v<decltype(by_type) &, double>);
+static_assert(!std::is_invocable_v<decltype(by_type) &, const char *>);
+// The cvref-qualifiers of the argument still need to be accepted by the functor.
+static_assert(!std::is_invocable_v<decltype(by_type) &, float &>);
+// A `mutable` functor can't be called on a const object.
+static_assert(!std::is_invocable_v<decltype(by_type) &, char>);
+static_assert(std::is_invocable_v<std::remove_const_t<decltype(by_type)> &, char>);
@@ -0,0 +1,37 @@
+#include "em/meta/poly_collection.h"
+
+struct Shape
+{
+    virtual ~Shape() = default;
+    virtual int Area() const = 0;
+};
+struct Square final : Shape
+{
+    int side = 0;
+    Square(int side) : side(side) {}
+    int Area() const override {return side * side;}
+};
+struct Rect final : Shape
+{
+    int w = 0, h = 0;
+    Rect(int w, int h) : w(w), h(h) {}
+    int Area() const override {return w * h;}
+};
+
+using C = em::Meta::PolyCollection<Shape, em::Meta::TypeList<Square, Rect>>;
+
+static_assert(std::is_same_v<C::types, em::Meta::TypeList<Square, Rect>>);
+static_assert(C::index_of<Rect> == 1);
+static_assert(std::is_same_v<decltype(std::declval<C &>().Segment<Rect>()), std::vector<Rect> &>);
+static_assert(std::is_same_v<decltype(std::declval<const C &>().Segment<Rect>()), const std::vector<Rect> &>);
+static_assert(std::is_same_v<decltype(std::declval<C &>().Emplace<Rect>(1, 2)), Rect &>);
+static_assert(std::is_same_v<decltype(std::declval<C &>().Insert(Square(1))), Square &>);
+
+// Unlisted types are rejected.
+template <typename T> concept CanInsert = requires(C &c, T &&t){c.Insert(std::forward<T>(t));};
+static_assert(CanInsert<Square> && CanInsert<const Rect &>);
+static_assert(!CanInsert<Shape &> && !CanInsert<int>);
+
+// Iteration passes the exact types.
+static_assert(std::is_void_v<decltype(std::declval<C &>().ForEach([]<typename T>(T &) {static_assert(std::is_same_v<T, Square> || std::is_same_v<T, Rect>);}))>);
+static_assert(std::is_same_v<decltype(std::declval<const C &>().ForEach<em::Meta::LoopAnyOf<>>([](const auto &shape){return shape.Area() > 10;})), bool>);
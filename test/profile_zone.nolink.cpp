@@ -0,0 +1,29 @@
+#include "em/meta/profile_zone.h"
+
+#include <type_traits>
+
+using em::Meta::operator""_c;
+
+// Naming.
+static_assert(em::Meta::ProfileZone<"draw"_c>::name == "draw");
+static_assert(em::Meta::ProfileZone<""_c>::name.empty());
+static_assert(!std::is_same_v<em::Meta::ProfileZone<"a"_c>, em::Meta::ProfileZone<"b"_c>>);
+
+// Only `"..."_c` is accepted as the name.
+template <auto Name>
+concept ValidZoneName = requires{typename em::Meta::ProfileZone<Name>;};
+static_assert(ValidZoneName<"x"_c>);
+static_assert(!ValidZoneName<42>);
+static_assert(!ValidZoneName<em::Meta::ConstString("x")>);
+
+// Zones are scoped and can't be copied.
+static_assert(std::is_default_constructible_v<em::Meta::ProfileZone<"x"_c>>);
+static_assert(!std::is_copy_constructible_v<em::Meta::ProfileZone<"x"_c>>);
+static_assert(!std::is_copy_assignable_v<em::Meta::ProfileZone<"x"_c>>);
+
+// When the zones are compiled out, they are empty.
+#if EM_PROFILE_ZONES
+static_assert(!std::is_empty_v<em::Meta::ProfileZone<"x"_c>>);
+#else
+static_assert(std::is_empty_v<em::Meta::ProfileZone<"x"_c>>);
+#endif
@@ -18,3 +18,22 @@ struct Y
 static_assert(std::is_same_v<em::Meta::reduce_types_indirect<Y, int>, int>);
 static_assert(std::is_same_v<em::Meta::reduce_types_indirect<Y, std::integral_constant<int,10>, std::integral_constant<int,20>>, std::integral_constant<int,30>>);
 static_assert(std::is_same_v<em::Meta::reduce_types_indirect<Y, std::integral_constant<int,10>, std::integral_constant<int,20>, std::integral_constant<int,30>>, std::integral_constant<int,60>>);
+
+static_assert(std::is_same_v<em::Meta::reduce_types_tree<X, int>, int>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree<X, std::integral_constant<int,10>, std::integral_constant<int,20>>, std::integral_constant<int,30>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree<X, std::integral_constant<int,10>, std::integral_constant<int,20>, std::integral_constant<int,30>>, std::integral_constant<int,60>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree_indirect<Y, int>, int>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree_indirect<Y, std::integral_constant<int,1>, std::integral_constant<int,2>, std::integral_constant<int,3>, std::integral_constant<int,4>, std::integral_constant<int,5>>, std::integral_constant<int,15>>);
+
+static_assert(std::is_same_v<em::Meta::reduce_types_left<X, int>, int>);
+static_assert(std::is_same_v<em::Meta::reduce_types_left<X, std::integral_constant<int,10>, std::integral_constant<int,20>, std::integral_constant<int,30>>, std::integral_constant<int,60>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_left_indirect<Y, int>, int>);
+static_assert(std::is_same_v<em::Meta::reduce_types_left_indirect<Y, std::integral_constant<int,10>, std::integral_constant<int,20>, std::integral_constant<int,30>>, std::integral_constant<int,60>>);
+
+// The order of operands.
+template <typename A, typename B> struct Pair {};
+template <int> struct L {};
+static_assert(std::is_same_v<em::Meta::reduce_types<Pair, L<0>, L<1>, L<2>>, Pair<L<0>, Pair<L<1>, L<2>>>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree<Pair, L<0>, L<1>, L<2>>, Pair<L<0>, Pair<L<1>, L<2>>>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_tree<Pair, L<0>, L<1>, L<2>, L<3>>, Pair<Pair<L<0>, L<1>>, Pair<L<2>, L<3>>>>);
+static_assert(std::is_same_v<em::Meta::reduce_types_left<Pair, L<0>, L<1>, L<2>>, Pair<Pair<L<0>, L<1>>, L<2>>>);
@@ -0,0 +1,33 @@
+#include "em/meta/soa_vector.h"
+
+#include <memory>
+#include <string>
+
+using V = em::Meta::SoAVector<float, int, std::string>;
+
+static_assert(V::num_fields == 3);
+static_assert(V::array_alignment == 64);
+static_assert(std::is_copy_constructible_v<V> && std::is_nothrow_move_constructible_v<V>);
+static_assert(!std::is_copy_constructible_v<em::Meta::SoAVector<std::unique_ptr<int>>>);
+static_assert(std::is_nothrow_move_constructible_v<em::Meta::SoAVector<std::unique_ptr<int>>>);
+
+// Fields.
+static_assert(std::is_same_v<decltype(std::declval<V &>().Field<1>()), std::span<int>>);
+static_assert(std::is_same_v<decltype(std::declval<const V &>().Field<2>()), std::span<const std::string>>);
+
+// Rows.
+static_assert(std::is_same_v<decltype(std::declval<V &>()[0].get<0>()), float &>);
+static_assert(std::is_same_v<decltype(std::declval<const V &>()[0].get<0>()), const float &>);
+static_assert(std::is_convertible_v<V::row, V::const_row> && !std::is_convertible_v<V::const_row, V::row>);
+static_assert(std::tuple_size_v<V::row> == 3);
+static_assert(std::is_same_v<std::tuple_element_t<2, V::const_row>, const std::string &>);
+
+// Adding elements.
+template <typename T, typename ...P> concept CanPushBack = requires(T &t, P &&... p){t.PushBack(std::forward<P>(p)...);};
+static_assert(CanPushBack<V, float, int, const char *>);
+static_assert(!CanPushBack<V, float, int>);
+static_assert(!CanPushBack<V, float, int, int>);
+
+// Lists.
+static_assert(std::is_same_v<em::Meta::SoAVector<em::Meta::TypeList<int, char>>::types, em::Meta::TypeList<int, char>>);
+static_assert(std::is_same_v<decltype(std::declval<em::Meta::SoAVector<em::Meta::TypeList<int, char>> &>().Field<1>()), std::span<char>>);
@@ -0,0 +1,66 @@
+#include "em/meta/tuple.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The layout.
+static_assert(sizeof(em::Meta::Tuple<char, std::int32_t, char, std::int32_t>) == 12);
+static_assert(sizeof(em::Meta::Tuple<char, double, char>) == 16);
+static_assert(std::is_empty_v<em::Meta::Tuple<>>);
+struct Empty {};
+static_assert(sizeof(em::Meta::Tuple<Empty, int>) == sizeof(int));
+
+// The logical order is preserved.
+static_assert(em::Meta::detail::Tuple::physical_order<char, std::int32_t, char, double> == std::array<std::size_t, 4>{3, 1, 0, 2});
+static_assert([]{
+    em::Meta::Tuple<char, std::int32_t, char, double> t('a', 2, 'b', 4.5);
+    return t.get<0>() == 'a' && t.get<1>() == 2 && em::Meta::get<2>(t) == 'b' && em::Meta::get<3>(t) == 4.5;
+}());
+static_assert([]{
+    em::Meta::Tuple<char, std::int32_t> t;
+    t.get<1>() = 42;
+    auto [a, b] = t;
+    return a == 0 && b == 42;
+}());
+
+// Cvref-qualifiers.
+using T = em::Meta::Tuple<int, const int, int &, int &&>;
+static_assert(std::is_same_v<decltype(std::declval<T &>().get<0>()), int &>);
+static_assert(std::is_same_v<decltype(std::declval<T &&>().get<0>()), int &&>);
+static_assert(std::is_same_v<decltype(std::declval<const T &>().get<0>()), const int &>);
+static_assert(std::is_same_v<decltype(std::declval<T &>().get<1>()), const int &>);
+static_assert(std::is_same_v<decltype(std::declval<const T &>().get<2>()), int &>);
+static_assert(std::is_same_v<decltype(std::declval<T &>().get<3>()), int &>);
+static_assert(std::is_same_v<decltype(std::declval<T &&>().get<3>()), int &&>);
+
+// Construction.
+static_assert(!std::is_default_constructible_v<T>);
+static_assert(std::is_constructible_v<em::Meta::Tuple<std::string, int>, const char *, short>);
+static_assert(!std::is_constructible_v<em::Meta::Tuple<std::string, int>, int, int>);
+static_assert(!std::is_constructible_v<em::Meta::Tuple<int, int>, int>);
+static_assert(std::is_same_v<decltype(em::Meta::Tuple(1, 2.f)), em::Meta::Tuple<int, float>>);
+
+// Elements are direct-initialized, and the constructor is explicit if any conversion is.
+struct Explicit
+{
+    int x = 0;
+    constexpr explicit Explicit(int x) : x(x) {}
+};
+static_assert([]{
+    em::Meta::Tuple<Explicit, int> t(5, 1);
+    return t.get<0>().x == 5 && t.get<1>() == 1;
+}());
+static_assert(std::is_constructible_v<em::Meta::Tuple<Explicit>, int> && !std::is_convertible_v<int, em::Meta::Tuple<Explicit>>);
+static_assert(std::is_constructible_v<em::Meta::Tuple<std::vector<int>, int>, int, int>);
+static_assert(std::is_convertible_v<const char *, em::Meta::Tuple<std::string>>);
+
+// Comparison.
+static_assert(em::Meta::Tuple(1, 'a') == em::Meta::Tuple(1, 'a'));
+static_assert(em::Meta::Tuple(1, 'a') != em::Meta::Tuple(1, 'b'));
+
+// Lists.
+static_assert(std::is_same_v<em::Meta::list_apply_types<em::Meta::Tuple, em::Meta::TypeList<int, char>>, em::Meta::Tuple<int, char>>);
+static_assert(std::is_same_v<em::Meta::Tuple<em::Meta::TypeList<int, char>>::types, em::Meta::TypeList<int, char>>);
+static_assert(std::tuple_size_v<em::Meta::Tuple<em::Meta::TypeList<int, char>>> == 2);
+static_assert([]{em::Meta::Tuple<em::Meta::TypeList<int, char>> t(1, 'a'); return t.get<1>() == 'a';}());
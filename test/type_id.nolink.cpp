@@ -0,0 +1,11 @@
+#include "em/meta/type_id.h"
+
+static_assert(em::Meta::type_id<int> == em::Meta::type_id<int>);
+static_assert(em::Meta::type_id<int> != em::Meta::type_id<float>);
+static_assert(em::Meta::type_id<int> != em::Meta::type_id<const int>);
+static_assert(em::Meta::type_id<int> != em::Meta::type_id<int &>);
+static_assert(em::Meta::type_id<int> != em::Meta::TypeId{});
+static_assert(!em::Meta::TypeId{});
+
+static_assert(em::Meta::type_id<int>.hash() == em::Meta::type_hash<int>);
+static_assert(em::Meta::type_hash<int> != em::Meta::type_hash<float>);
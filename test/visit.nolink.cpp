@@ -0,0 +1,41 @@
+#include "em/meta/overload.h"
+#include "em/meta/visit.h"
+
+#include <array>
+#include <variant>
+
+using V = std::variant<int, float, char>;
+using W = std::variant<int, long, short, char>;
+
+static constexpr auto handler = em::Meta::Overload{
+    [](int) {return 1;},
+    [](float) {return 2;},
+    [](char) {return 3;},
+};
+
+// One variant, dispatched with branches.
+static_assert(em::Meta::Visit(handler, V(1)) == 1);
+static_assert(em::Meta::Visit(handler, V(1.f)) == 2);
+static_assert(em::Meta::Visit(handler, V('a')) == 3);
+
+// Several variants, dispatched with a table (3 * 4 combinations).
+static constexpr auto pair_handler = []<typename A, typename B>(A, B){return int(sizeof(A)) * 10 + int(sizeof(B));};
+static_assert(em::Meta::Visit(pair_handler, V(1), W(1)) == 44);
+static_assert(em::Meta::Visit(pair_handler, V('a'), W(short(1))) == 12);
+static_assert(em::Meta::Visit(pair_handler, V(1.f), W('a')) == 41);
+static_assert(em::Meta::Visit(pair_handler, V('a'), W(1L)) == 10 + int(sizeof(long)));
+
+// References are forwarded.
+static_assert([]{V v(1); em::Meta::Visit([](auto &x){x = 42;}, v); return std::get<int>(v);}() == 42);
+static_assert(std::is_same_v<decltype(em::Meta::Visit([](auto &&x) -> auto && {return x;}, std::declval<std::variant<int> &>())), int &>);
+
+// Early exit over a range.
+static_assert([]{
+    std::array<V, 4> arr = {V(1), V('a'), V(2.f), V('b')};
+    int count = 0;
+    bool found = em::Meta::VisitEach<em::Meta::LoopAnyOf<>>(arr.begin(), arr.end(), em::Meta::Overload{
+        [&](char) {count++; return true;},
+        [&](auto) {count++; return false;},
+    });
+    return found && count == 2;
+}());